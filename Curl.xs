@@ -116,19 +116,50 @@ typedef struct {
 
 	/* user data */
 	SV *data;
+
+	/* method func resolves to, valid for given stash and generation */
+	CV *cv;
+	HV *stash;
+	U32 gen;
 } callback_t;
 
-typedef struct simplell_s simplell_t;
-struct simplell_s {
-	/* next in the linked list */
-	simplell_t *next;
+/* forget resolved method after func changes */
+#define CALLBACK_RESET( cb )			\
+	STMT_START {						\
+		(cb).cv = NULL;					\
+		(cb).stash = NULL;				\
+	} STMT_END
+
+/* changes whenever any method visible in stash may have changed */
+#ifdef HvMROMETA
+# define STASH_GENERATION( stash )							\
+	( PL_sub_generation + ( HvAUX( stash )->xhv_mro_meta		\
+		? HvAUX( stash )->xhv_mro_meta->pkg_gen				\
+			+ HvAUX( stash )->xhv_mro_meta->cache_gen : 0 ) )
+#else
+# define STASH_GENERATION( stash ) PL_sub_generation
+#endif
 
-	/* curl option it belongs to */
+/* open addressing hash, keyed by pointer, fd or option number */
+typedef struct {
+	/* curl option, fd or pointer it belongs to */
 	PTRV key;
 
 	/* the actual data */
 	void *value;
-};
+} ptrhash_entry_t;
+
+typedef struct {
+	/* array of size slots, size is a power of 2 */
+	ptrhash_entry_t *slots;
+	size_t size;
+
+	/* number of used slots */
+	size_t count;
+} ptrhash_t;
+
+/* marks unused slot, not a valid pointer, fd nor option */
+#define PTRHASH_EMPTY ( (PTRV) -1 )
 
 //----------------------------------------------------------------------
 
@@ -150,19 +181,55 @@ struct perl_curl_multi_s {
 
 	/* list of data assigned to sockets */
 	/* key: socket fd; value: user sv */
-	simplell_t *socket_data;
+	ptrhash_t socket_data;
 
 	/* list of easy handles attached to this multi */
 	/* key: our easy pointer, value: easy SV */
-	simplell_t *easies;
+	ptrhash_t easies;
+
+	/* sockets curl wants us to watch, as reported to socket callback */
+	/* key: socket fd; value: CURL_POLL_* */
+	ptrhash_t sockets;
+
+	/* internal event loop used by run(), NULL until first used */
+	struct perl_curl_multi_loop_s *loop;
+
+	/* admission queue of enqueue(), NULL until first used */
+	struct perl_curl_sched_s *sched;
+
+	/* see wakeup_fd(): read and write end, -1 if not created */
+	int wakeup_fd[ 2 ];
+
+	/* completed transfers per host, see collect_latency() */
+	/* key: hash of host name; value: perl_curl_latency_t list */
+	ptrhash_t latency;
+	int collect_latency;
 };
 
 //----------------------------------------------------------------------
 
 typedef struct perl_curl_easy_s perl_curl_easy_t;
+typedef struct perl_curl_executor_s perl_curl_executor_t;
+typedef struct perl_curl_executor_job_s perl_curl_executor_job_t;
 typedef struct perl_curl_form_s perl_curl_form_t;
+typedef struct perl_curl_mime_s perl_curl_mime_t;
 typedef struct perl_curl_share_s perl_curl_share_t;
 typedef struct perl_curl_multi_s perl_curl_multi_t;
+typedef struct perl_curl_sink_s perl_curl_sink_t;
+typedef struct perl_curl_fdset_s perl_curl_fdset_t;
+typedef struct perl_curl_template_s perl_curl_template_t;
+typedef struct perl_curl_pool_s perl_curl_pool_t;
+typedef struct perl_curl_slist_s perl_curl_slist_t;
+typedef struct perl_curl_source_s perl_curl_source_t;
+typedef struct perl_curl_resolver_s perl_curl_resolver_t;
+
+/* Net::Curl::Mime, easy handle rewinds its sources before transfer
+ * and counts mimes it posts */
+#if LIBCURL_VERSION_NUM >= 0x073800
+# define PERL_CURL_MIME
+static void perl_curl_mime_rewind( perl_curl_mime_t *mime );
+static void perl_curl_mime_post( pTHX_ SV *sv, int delta );
+#endif
 
 static struct curl_slist *
 perl_curl_array2slist( pTHX_ struct curl_slist *slist, SV *arrayref )
@@ -170,7 +237,8 @@ perl_curl_array2slist( pTHX_ struct curl_slist *slist, SV *arrayref )
 	AV *array;
 	int array_len, i;
 
-	if ( !SvOK( arrayref ) || !SvROK( arrayref ) )
+	if ( !SvOK( arrayref ) || !SvROK( arrayref )
+			|| SvTYPE( SvRV( arrayref ) ) != SVt_PVAV )
 		croak( "not an array" );
 
 	array = (AV *) SvRV( arrayref );
@@ -190,83 +258,298 @@ perl_curl_array2slist( pTHX_ struct curl_slist *slist, SV *arrayref )
 	return slist;
 }
 
-#if 0
-static void *
-perl_curl_simplell_get( pTHX_ simplell_t *start, PTRV key )
+/* curl_slist which may be used by many easy handles and templates */
+struct perl_curl_slist_s {
+	/* always NULL, slists are not passed to callbacks */
+	SV *perl_self;
+
+	struct curl_slist *list;
+
+	/* number of users, list is freed when it drops to 0 */
+	long refcnt;
+};
+
+static perl_curl_slist_t *
+perl_curl_slist_new( struct curl_slist *list )
+{
+	perl_curl_slist_t *slist;
+
+	Newxz( slist, 1, perl_curl_slist_t );
+	slist->list = list;
+	slist->refcnt = 1;
+
+	return slist;
+}
+
+static perl_curl_slist_t *
+perl_curl_slist_ref( perl_curl_slist_t *slist )
 {
-	simplell_t *now = start;
+	slist->refcnt++;
+	return slist;
+}
+
+static void
+perl_curl_slist_unref( perl_curl_slist_t *slist )
+{
+	if ( --slist->refcnt > 0 )
+		return;
+
+	curl_slist_free_all( slist->list );
+	Safefree( slist );
+}
+
+/* append copies of all entries of a curl_slist */
+static struct curl_slist *
+perl_curl_slist_append_list( struct curl_slist *out,
+		const struct curl_slist *in )
+{
+	for ( ; in; in = in->next )
+		out = curl_slist_append( out, in->data );
+
+	return out;
+}
+
+/* private copy of a curl_slist */
+#define perl_curl_slist_copy( in ) perl_curl_slist_append_list( NULL, in )
+
+static size_t
+perl_curl_ptrhash_slot( const ptrhash_t *hash, PTRV key )
+{
+	UV k = (UV) key;
 
-	if ( now == NULL )
+	/* mix the bits, pointers are aligned and fds are sequential */
+#if UVSIZE == 8
+	k ^= k >> 33;
+	k *= UINT64_C( 0xff51afd7ed558ccd );
+	k ^= k >> 33;
+#else
+	k ^= k >> 16;
+	k *= 0x85ebca6bU;
+	k ^= k >> 13;
+#endif
+
+	return (size_t) k & ( hash->size - 1 );
+}
+
+static ptrhash_entry_t *
+perl_curl_ptrhash_entry( const ptrhash_t *hash, PTRV key )
+{
+	size_t i;
+
+	if ( hash->count == 0 )
 		return NULL;
 
-	while ( now ) {
-		if ( now->key == key )
-			return &(now->value);
-		if ( now->key > key )
+	for ( i = perl_curl_ptrhash_slot( hash, key ); ;
+			i = ( i + 1 ) & ( hash->size - 1 ) ) {
+		ptrhash_entry_t *e = &hash->slots[ i ];
+		if ( e->key == key )
+			return e;
+		if ( e->key == PTRHASH_EMPTY )
 			return NULL;
-		now = now->next;
 	}
+}
 
-	return NULL;
+/* returns pointer to value stored for key, or NULL if there is none */
+static void *
+perl_curl_ptrhash_get( pTHX_ ptrhash_t *hash, PTRV key )
+{
+	ptrhash_entry_t *e = perl_curl_ptrhash_entry( hash, key );
+	return e ? &e->value : NULL;
 }
-#endif
 
+static void
+perl_curl_ptrhash_resize( pTHX_ ptrhash_t *hash, size_t size )
+{
+	ptrhash_entry_t *old = hash->slots;
+	size_t oldsize = hash->size;
+	size_t i;
+
+	Newx( hash->slots, size, ptrhash_entry_t );
+	hash->size = size;
+	for ( i = 0; i < size; i++ )
+		hash->slots[ i ].key = PTRHASH_EMPTY;
+
+	for ( i = 0; i < oldsize; i++ ) {
+		size_t j;
+		if ( old[ i ].key == PTRHASH_EMPTY )
+			continue;
+		j = perl_curl_ptrhash_slot( hash, old[ i ].key );
+		while ( hash->slots[ j ].key != PTRHASH_EMPTY )
+			j = ( j + 1 ) & ( size - 1 );
+		hash->slots[ j ] = old[ i ];
+	}
+
+	Safefree( old );
+}
 
+/*
+ * Find or create an entry for key, returns pointer to its value.
+ * The pointer is valid only until next add.
+ */
 static void *
-perl_curl_simplell_add( pTHX_ simplell_t **start, PTRV key )
+perl_curl_ptrhash_add( pTHX_ ptrhash_t *hash, PTRV key )
 {
-	simplell_t **now = start;
-	simplell_t *tmp = NULL;
-
-	while ( *now ) {
-		if ( (*now)->key == key )
-			return &( (*now)->value );
-		if ( (*now)->key > key )
-			break;
-		now = &( (*now)->next );
-	}
+	size_t i;
+	void *value;
+
+	value = perl_curl_ptrhash_get( aTHX_ hash, key );
+	if ( value )
+		return value;
 
-	tmp = *now;
-	Newx( *now, 1, simplell_t );
-	(*now)->next = tmp;
-	(*now)->key = key;
-	(*now)->value = NULL;
+	/* keep load factor below 1/2 */
+	if ( ( hash->count + 1 ) * 2 > hash->size )
+		perl_curl_ptrhash_resize( aTHX_ hash, hash->size ? hash->size * 2 : 8 );
 
-	return &( (*now)->value );
+	i = perl_curl_ptrhash_slot( hash, key );
+	while ( hash->slots[ i ].key != PTRHASH_EMPTY )
+		i = ( i + 1 ) & ( hash->size - 1 );
+
+	hash->slots[ i ].key = key;
+	hash->slots[ i ].value = NULL;
+	hash->count++;
+
+	return &hash->slots[ i ].value;
 }
 
+/* remove key, returns its value */
 static void *
-perl_curl_simplell_del( pTHX_ simplell_t **start, PTRV key )
+perl_curl_ptrhash_del( pTHX_ ptrhash_t *hash, PTRV key )
 {
-	simplell_t **now = start;
-
-	while ( *now ) {
-		if ( (*now)->key == key ) {
-			void *ret = (*now)->value;
-			simplell_t *tmp = *now;
-			*now = (*now)->next;
-			Safefree( tmp );
-			return ret;
+	ptrhash_entry_t *e;
+	void *ret;
+	size_t i, j, mask;
+
+	e = perl_curl_ptrhash_entry( hash, key );
+	if ( !e )
+		return NULL;
+
+	ret = e->value;
+	mask = hash->size - 1;
+	i = e - hash->slots;
+
+	/* backward shift deletion, no tombstones */
+	for ( j = ( i + 1 ) & mask; hash->slots[ j ].key != PTRHASH_EMPTY;
+			j = ( j + 1 ) & mask ) {
+		size_t home = perl_curl_ptrhash_slot( hash, hash->slots[ j ].key );
+		/* move entry j to i if its home is not within (i, j] */
+		if ( ( ( j - home ) & mask ) >= ( ( j - i ) & mask ) ) {
+			hash->slots[ i ] = hash->slots[ j ];
+			i = j;
 		}
-		if ( (*now)->key > key )
-			return NULL;
-		now = &( (*now)->next );
 	}
-	return NULL;
+	hash->slots[ i ].key = PTRHASH_EMPTY;
+	hash->count--;
+
+	return ret;
 }
 
-#define SIMPLELL_FREE( list, freefunc )			\
-	STMT_START {								\
-		if ( list ) {							\
-			simplell_t *next, *now = list;		\
-			do {								\
-				next = now->next;				\
-				freefunc( now->value );			\
-				Safefree( now );				\
-			} while ( ( now = next ) != NULL );	\
-		}										\
+#define PTRHASH_FOREACH( hash, entry )						\
+	for ( entry = (hash).slots;								\
+		entry && entry < (hash).slots + (hash).size; entry++ )	\
+		if ( entry->key != PTRHASH_EMPTY )
+
+#define PTRHASH_FREE( hash, freefunc )						\
+	STMT_START {											\
+		ptrhash_entry_t *e_;								\
+		PTRHASH_FOREACH( hash, e_ )							\
+			freefunc( e_->value );							\
+		Safefree( (hash).slots );							\
+		(hash).slots = NULL;								\
+		(hash).size = (hash).count = 0;						\
 	} STMT_END
 
+/* case insensitive hash of a name, usable as ptrhash key */
+static PTRV
+perl_curl_nocase_key( const char *name, STRLEN len )
+{
+	PTRV h = (PTRV) 2166136261U;
+
+	for ( ; len; len--, name++ )
+		h = ( h ^ (unsigned char) toLOWER( *name ) ) * 16777619U;
+	return h == PTRHASH_EMPTY ? 0 : h;
+}
+
+
+/*
+ * Code to call for a method name callback. Method is looked up once and
+ * reused until the invocant is blessed into another package or methods
+ * of the package change. NULL if it must be called by name.
+ */
+static CV *
+perl_curl_callback_cv( pTHX_ callback_t *cb, SV *self )
+{
+	HV *stash;
+	GV *gv;
+	CV *cv;
+	U32 gen;
+
+	if ( !self || !SvROK( self ) || !SvOBJECT( SvRV( self ) ) )
+		return NULL;
+
+	stash = SvSTASH( SvRV( self ) );
+	gen = STASH_GENERATION( stash );
+	if ( cb->cv && cb->stash == stash && cb->gen == gen )
+		return cb->cv;
+
+	/* AUTOLOAD needs $AUTOLOAD set on every call, leave it to perl */
+	gv = gv_fetchmethod_autoload( stash, SvPV_nolen( cb->func ), FALSE );
+	if ( !gv )
+		return NULL;
+	cv = SvTYPE( gv ) == SVt_PVCV ? (CV *) gv : GvCV( gv );
+	if ( !cv )
+		return NULL;
+
+	cb->cv = cv;
+	cb->stash = stash;
+	cb->gen = gen;
+
+	return cv;
+}
+
+/* call cb with arguments already on the stack, self is the first one */
+static void
+perl_curl_callback_dispatch( pTHX_ callback_t *cb, SV *self )
+{
+	CV *cv;
+
+	if ( SvROK( cb->func ) )
+		call_sv( cb->func, G_SCALAR | G_EVAL );
+	else if ( ( cv = perl_curl_callback_cv( aTHX_ cb, self ) ) )
+		call_sv( (SV *) cv, G_SCALAR | G_EVAL );
+	else
+		call_method( SvPV_nolen( cb->func ), G_SCALAR | G_EVAL );
+}
+
+/*
+ * userdata is pushed without a copy, but read-only for the duration of
+ * the call: assigning to $_[N] croaks instead of changing the stored value;
+ * the extra reference keeps it alive if the callback replaces the option
+ */
+static bool
+perl_curl_data_lock( pTHX_ SV *data )
+{
+	bool was_ro;
+
+	if ( !data )
+		return TRUE;
+
+	SvREFCNT_inc_simple_void_NN( data );
+	was_ro = SvREADONLY( data ) ? TRUE : FALSE;
+	SvREADONLY_on( data );
+
+	return was_ro;
+}
+
+static void
+perl_curl_data_unlock( pTHX_ SV *data, bool was_ro )
+{
+	if ( !data )
+		return;
+
+	if ( !was_ro )
+		SvREADONLY_off( data );
+	SvREFCNT_dec( data );
+}
 
 /* generic function for our callback calling needs */
 static IV
@@ -275,17 +558,13 @@ perl_curl_call( pTHX_ callback_t *cb, int argnum, SV **args )
 	dSP;
 	int i;
 	IV status;
-	SV *olderrsv = NULL;
-	int method_call = 0;
+	SV *data = cb->data;
+	bool data_ro;
 
 	if ( ! cb->func || ! SvOK( cb->func ) ) {
 		warn( "callback function is not set\n" );
 		return -1;
-	} else if ( SvROK( cb->func ) )
-		method_call = 0;
-	else if ( SvPOK( cb->func ) )
-		method_call = 1;
-	else {
+	} else if ( ! SvROK( cb->func ) && ! SvPOK( cb->func ) ) {
 		warn( "Don't know how to call the callback\n" );
 		return -1;
 	}
@@ -295,22 +574,21 @@ perl_curl_call( pTHX_ callback_t *cb, int argnum, SV **args )
 
 	PUSHMARK( SP );
 
-	EXTEND( SP, argnum );
+	EXTEND( SP, argnum + 1 );
 	for ( i = 0; i < argnum; i++ )
 		mPUSHs( args[ i ] );
 
-	if ( cb->data )
-		mXPUSHs( newSVsv( cb->data ) );
+	data_ro = perl_curl_data_lock( aTHX_ data );
+	if ( data )
+		PUSHs( data );
 
 	PUTBACK;
 
+	/* callback must not clobber $@ of the caller, local $@ */
 	if ( SvTRUE( ERRSV ) )
-		olderrsv = sv_2mortal( newSVsv( ERRSV ) );
+		save_scalar( PL_errgv );
 
-	if ( method_call )
-		call_method( SvPV_nolen( cb->func ), G_SCALAR | G_EVAL );
-	else
-		call_sv( cb->func, G_SCALAR | G_EVAL );
+	perl_curl_callback_dispatch( aTHX_ cb, argnum ? args[0] : NULL );
 
 	SPAGAIN;
 
@@ -322,10 +600,8 @@ perl_curl_call( pTHX_ callback_t *cb, int argnum, SV **args )
 		status = POPi;
 	}
 
-	if ( olderrsv )
-		sv_setsv( ERRSV, olderrsv );
-
 	PUTBACK;
+	perl_curl_data_unlock( aTHX_ data, data_ro );
 	FREETMPS;
 	LEAVE;
 
@@ -455,17 +731,32 @@ struct pv_s {
 
 
 typedef perl_curl_easy_t *Net__Curl__Easy;
+typedef perl_curl_template_t *Net__Curl__Easy__Template;
+typedef perl_curl_pool_t *Net__Curl__Easy__Pool;
+typedef perl_curl_executor_t *Net__Curl__Executor;
 typedef perl_curl_form_t *Net__Curl__Form;
+typedef perl_curl_mime_t *Net__Curl__Mime;
 typedef perl_curl_multi_t *Net__Curl__Multi;
+typedef perl_curl_fdset_t *Net__Curl__Multi__FdSet;
+typedef perl_curl_resolver_t *Net__Curl__Resolver;
 typedef perl_curl_share_t *Net__Curl__Share;
+typedef perl_curl_sink_t *Net__Curl__Sink;
+typedef perl_curl_slist_t *Net__Curl__Slist;
+typedef perl_curl_source_t *Net__Curl__Source;
 
 /* default base object */
 #define HASHREF_BY_DEFAULT		sv_2mortal( newRV_noinc( (SV *) newHV() ) )
 
+#include "curl-Sink-c.inc"
+#include "curl-Slist-c.inc"
+#include "curl-Source-c.inc"
 #include "curl-Easy-c.inc"
 #include "curl-Form-c.inc"
+#include "curl-Mime-c.inc"
 #include "curl-Multi-c.inc"
 #include "curl-Share-c.inc"
+#include "curl-Resolver-c.inc"
+#include "curl-Executor-c.inc"
 #include "Curl_Easy_setopt.c"
 
 MODULE = Net::Curl	PACKAGE = Net::Curl
@@ -596,6 +887,12 @@ version_info()
 
 
 INCLUDE: curl-Easy-xs.inc
+INCLUDE: curl-Executor-xs.inc
 INCLUDE: curl-Form-xs.inc
+INCLUDE: curl-Mime-xs.inc
 INCLUDE: curl-Multi-xs.inc
 INCLUDE: curl-Share-xs.inc
+INCLUDE: curl-Resolver-xs.inc
+INCLUDE: curl-Sink-xs.inc
+INCLUDE: curl-Slist-xs.inc
+INCLUDE: curl-Source-xs.inc
@@ -8,10 +8,18 @@
 
 
 static size_t
-write_to_ctx( pTHX_ SV* const call_ctx, const char* const ptr, size_t const n )
+write_to_ctx( pTHX_ SV* const call_ctx, perl_curl_sink_t *sink, int pausable,
+		const char* const ptr, size_t const n )
 {
 	PerlIO *handle;
 	SV* out_str;
+	if ( sink ) {
+		/* native destination, no need to enter perl */
+		if ( sink->owner )
+			/* an executor thread writes to it */
+			return 0;
+		return perl_curl_sink_write( sink, ptr, n, pausable );
+	}
 	if ( call_ctx ) { /* a GLOB or a SCALAR ref */
 		if( SvROK( call_ctx ) && SvTYPE( SvRV( call_ctx ) ) <= SVt_PVMG ) {
 			/* write to a scalar ref */
@@ -34,6 +42,66 @@ write_to_ctx( pTHX_ SV* const call_ctx, const char* const ptr, size_t const n )
 }
 
 
+/* content length of current response, -1 if unknown */
+static curl_off_t
+perl_curl_easy_content_length( perl_curl_easy_t *easy )
+/*{{{*/ {
+#ifdef CURLINFO_CONTENT_LENGTH_DOWNLOAD_T
+	curl_off_t cl;
+	if ( curl_easy_getinfo( easy->handle, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T,
+			&cl ) == CURLE_OK )
+		return cl;
+#else
+	double cl;
+	if ( curl_easy_getinfo( easy->handle, CURLINFO_CONTENT_LENGTH_DOWNLOAD,
+			&cl ) == CURLE_OK && cl >= 0 )
+		return (curl_off_t) cl;
+#endif
+	return -1;
+} /*}}}*/
+
+/* do not trust Content-Length with larger preallocations */
+#define PRESIZE_MAX		( (curl_off_t) 1 << 30 )
+
+/*
+ * Account n body bytes. On first chunk of a transfer preallocate scalar
+ * WRITEDATA to advertised Content-Length, so sv_catpvn never reallocates.
+ * Returns FALSE if transfer must be aborted because of max_body_bytes.
+ */
+static bool
+perl_curl_easy_body_chunk( pTHX_ perl_curl_easy_t *easy, size_t n )
+/*{{{*/ {
+	if ( easy->body_bytes < 0 ) {
+		callback_t *cb = &easy->cb[ CB_EASY_WRITE ];
+		curl_off_t cl = perl_curl_easy_content_length( easy );
+
+		easy->body_bytes = 0;
+		if ( easy->max_body_bytes && cl > easy->max_body_bytes )
+			return FALSE;
+
+		if ( cl > 0 && cl <= PRESIZE_MAX && !cb->func
+				&& !easy->sink[ CB_EASY_WRITE ] && cb->data
+				&& SvROK( cb->data )
+				&& SvTYPE( SvRV( cb->data ) ) <= SVt_PVMG ) {
+			SV *out_str = SvRV( cb->data );
+			STRLEN cur = 0;
+
+			if ( SvOK( out_str ) )
+				(void) SvPV_force( out_str, cur );
+			else
+				sv_setpvn( out_str, "", 0 );
+			SvGROW( out_str, cur + (STRLEN) cl + 1 );
+		}
+	}
+
+	easy->body_bytes += n;
+	if ( easy->max_body_bytes && easy->body_bytes > easy->max_body_bytes )
+		return FALSE;
+
+	return TRUE;
+} /*}}}*/
+
+
 /* WRITEFUNCTION -- WRITEDATA */
 static size_t
 cb_easy_write( char *buffer, size_t size, size_t nitems, void *userptr )
@@ -42,19 +110,34 @@ cb_easy_write( char *buffer, size_t size, size_t nitems, void *userptr )
 	perl_curl_easy_t *easy;
 	easy = (perl_curl_easy_t *) userptr;
 	callback_t *cb = &easy->cb[ CB_EASY_WRITE ];
+	size_t ret;
+
+	if ( !perl_curl_easy_body_chunk( aTHX_ easy, size * nitems ) )
+		return 0;
 
 	if ( cb->func ) {
 		SV *args[] = {
-			SELF2PERL( easy ),
+			perl_curl_easy_self( aTHX_ easy ),
 			&PL_sv_undef
 		};
 		if ( buffer )
-			args[1] = newSVpvn( buffer, (STRLEN) (size * nitems) );
+			args[1] = perl_curl_easy_buffer( aTHX_ easy, buffer,
+				(STRLEN) (size * nitems) );
 
-		return PERL_CURL_CALL( cb, args );
+		ret = PERL_CURL_CALL( cb, args );
+		perl_curl_easy_buffer_done( aTHX_ easy );
 	} else {
-		return write_to_ctx( aTHX_ cb->data, buffer, size * nitems );
+		ret = write_to_ctx( aTHX_ cb->data, easy->sink[ CB_EASY_WRITE ],
+			easy->multi != NULL, buffer, size * nitems );
 	}
+
+#ifdef CURL_WRITEFUNC_PAUSE
+	/* same data will be delivered again */
+	if ( ret == CURL_WRITEFUNC_PAUSE )
+		easy->body_bytes -= size * nitems;
+#endif
+
+	return ret;
 }
 
 
@@ -68,18 +151,30 @@ cb_easy_header( const void *ptr, size_t size, size_t nmemb,
 	easy = (perl_curl_easy_t *) userptr;
 	callback_t *cb = &easy->cb[ CB_EASY_HEADER ];
 
+	if ( easy->headers && ptr )
+		perl_curl_headers_add( easy->headers, ptr, size * nmemb );
+
 	if ( cb->func ) {
+		size_t ret;
 		SV *args[] = {
-			SELF2PERL( easy ),
+			perl_curl_easy_self( aTHX_ easy ),
 			&PL_sv_undef
 		};
 		if ( ptr )
-			args[1] = newSVpvn( ptr, (STRLEN) (size * nmemb) );
+			args[1] = perl_curl_easy_buffer( aTHX_ easy, ptr,
+				(STRLEN) (size * nmemb) );
 
-		return PERL_CURL_CALL( cb, args );
-	} else {
-		return write_to_ctx( aTHX_ cb->data, ptr, size * nmemb );
+		ret = PERL_CURL_CALL( cb, args );
+		perl_curl_easy_buffer_done( aTHX_ easy );
+
+		return ret;
+	} else if ( cb->data || easy->sink[ CB_EASY_HEADER ] || !easy->headers ) {
+		return write_to_ctx( aTHX_ cb->data, easy->sink[ CB_EASY_HEADER ],
+			easy->multi != NULL, ptr, size * nmemb );
 	}
+
+	/* collected only */
+	return size * nmemb;
 }
 
 
@@ -93,10 +188,17 @@ cb_easy_debug( CURL *easy_handle, curl_infotype type, char *ptr, size_t size,
 	easy = (perl_curl_easy_t *) userptr;
 	callback_t *cb = &easy->cb[ CB_EASY_DEBUG ];
 
+	if ( easy->trace ) {
+		perl_curl_trace_add( easy->trace, type, ptr, size );
+		/* recorded only */
+		if ( !cb->func && !cb->data && !easy->sink[ CB_EASY_DEBUG ] )
+			return 0;
+	}
+
 	if ( cb->func ) {
 		/* We are doing a callback to perl */
 		SV *args[] = {
-			SELF2PERL( easy ),
+			perl_curl_easy_self( aTHX_ easy ),
 			newSViv( type ),
 			&PL_sv_undef
 		};
@@ -105,7 +207,8 @@ cb_easy_debug( CURL *easy_handle, curl_infotype type, char *ptr, size_t size,
 
 		return PERL_CURL_CALL( cb, args );
 	} else {
-		return write_to_ctx( aTHX_ cb->data, ptr, size );
+		return write_to_ctx( aTHX_ cb->data, easy->sink[ CB_EASY_DEBUG ], 0,
+			ptr, size );
 	}
 
 }
@@ -129,40 +232,37 @@ cb_easy_read( char *ptr, size_t size, size_t nmemb, void *userptr )
 
 	if ( cb->func ) {
 		SV *sv;
+		SV *self;
+		SV *data = cb->data;
+		bool data_ro;
 		size_t status = CURL_READFUNC_ABORT;
-		SV *olderrsv = NULL;
-		int method_call = 0;
 
-		if ( SvROK( cb->func ) )
-			method_call = 0;
-		else if ( SvPOK( cb->func ) )
-			method_call = 1;
-		else {
+		if ( ! SvROK( cb->func ) && ! SvPOK( cb->func ) ) {
 			warn( "Don't know how to call the callback\n" );
 			return CURL_READFUNC_ABORT;
 		}
 
+		self = perl_curl_easy_self( aTHX_ easy );
+
 		ENTER;
 		SAVETMPS;
 
 		PUSHMARK( SP );
 
 		/* $easy, $maxsize, $userdata */
-		EXTEND( SP, 2 );
-		mPUSHs( SELF2PERL( easy ) ),
+		EXTEND( SP, 3 );
+		mPUSHs( self );
 		mPUSHs( newSViv( maxlen ) );
-		if ( cb->data )
-			mXPUSHs( newSVsv( cb->data ) );
+		data_ro = perl_curl_data_lock( aTHX_ data );
+		if ( data )
+			PUSHs( data );
 
 		PUTBACK;
 
 		if ( SvTRUE( ERRSV ) )
-			olderrsv = sv_2mortal( newSVsv( ERRSV ) );
+			save_scalar( PL_errgv );
 
-		if ( method_call )
-			call_method( SvPV_nolen( cb->func ), G_SCALAR | G_EVAL );
-		else
-			call_sv( cb->func, G_SCALAR | G_EVAL );
+		perl_curl_callback_dispatch( aTHX_ cb, self );
 
 		SPAGAIN;
 
@@ -203,14 +303,16 @@ cb_easy_read( char *ptr, size_t size, size_t nmemb, void *userptr )
 			sv_setpvf( ERRSV, "invalid return value in read callback" );
 		}
 
-		if ( olderrsv )
-			sv_setsv( ERRSV, olderrsv );
-
 		PUTBACK;
+		perl_curl_data_unlock( aTHX_ data, data_ro );
 		FREETMPS;
 		LEAVE;
 
 		return status;
+	} else if ( easy->source ) {
+		/* native source, no perl involved */
+		return perl_curl_source_read( easy->source, &easy->source_cur, ptr,
+			maxlen );
 	} else {
 		/* read input directly */
 		PerlIO *f;
@@ -235,15 +337,29 @@ cb_easy_progress( void *userptr, double dltotal, double dlnow,
 	easy = (perl_curl_easy_t *) userptr;
 	callback_t *cb = &easy->cb[ CB_EASY_PROGRESS ];
 
-	SV *args[] = {
-		SELF2PERL( easy ),
-		newSVnv( dltotal ),
-		newSVnv( dlnow ),
-		newSVnv( ultotal ),
-		newSVnv( ulnow )
-	};
+	switch ( perl_curl_easy_progress_tick( easy, (curl_off_t) dltotal,
+			(curl_off_t) dlnow, (curl_off_t) ultotal, (curl_off_t) ulnow ) ) {
+		case PROGRESS_ABORT:
+			return 1;
+		case PROGRESS_SKIP:
+			return 0;
+		default:
+			break;
+	}
+	if ( !cb->func )
+		return 0;
 
-	return PERL_CURL_CALL( cb, args );
+	{
+		SV *args[] = {
+			perl_curl_easy_self( aTHX_ easy ),
+			newSVnv( dltotal ),
+			newSVnv( dlnow ),
+			newSVnv( ultotal ),
+			newSVnv( ulnow )
+		};
+
+		return PERL_CURL_CALL( cb, args );
+	}
 }
 
 
@@ -259,15 +375,45 @@ cb_easy_xferinfo( void *userptr, curl_off_t dltotal, curl_off_t dlnow,
 	easy = (perl_curl_easy_t *) userptr;
 	callback_t *cb = &easy->cb[ CB_EASY_XFERINFO ];
 
-	SV *args[] = {
-		SELF2PERL( easy ),
-		newSViv( dltotal ),
-		newSViv( dlnow ),
-		newSViv( ultotal ),
-		newSViv( ulnow )
-	};
+	switch ( perl_curl_easy_progress_tick( easy, dltotal, dlnow,
+			ultotal, ulnow ) ) {
+		case PROGRESS_ABORT:
+			return 1;
+		case PROGRESS_SKIP:
+			return 0;
+		default:
+			break;
+	}
 
-	return PERL_CURL_CALL( cb, args );
+	/* installed for progress policies, perl may want the old callback */
+	if ( !cb->func ) {
+		cb = &easy->cb[ CB_EASY_PROGRESS ];
+		if ( !cb->func )
+			return 0;
+		{
+			SV *args[] = {
+				perl_curl_easy_self( aTHX_ easy ),
+				newSVnv( (NV) dltotal ),
+				newSVnv( (NV) dlnow ),
+				newSVnv( (NV) ultotal ),
+				newSVnv( (NV) ulnow )
+			};
+
+			return PERL_CURL_CALL( cb, args );
+		}
+	}
+
+	{
+		SV *args[] = {
+			perl_curl_easy_self( aTHX_ easy ),
+			newSViv( dltotal ),
+			newSViv( dlnow ),
+			newSViv( ultotal ),
+			newSViv( ulnow )
+		};
+
+		return PERL_CURL_CALL( cb, args );
+	}
 }
 #endif
 
@@ -283,7 +429,7 @@ cb_easy_ioctl( CURL *easy_handle, int cmd, void *userptr )
 	callback_t *cb = &easy->cb[ CB_EASY_IOCTL ];
 
 	SV *args[] = {
-		SELF2PERL( easy ),
+		perl_curl_easy_self( aTHX_ easy ),
 		newSViv( cmd ),
 	};
 
@@ -302,8 +448,14 @@ cb_easy_seek( void *userptr, curl_off_t offset, int origin )
 	easy = (perl_curl_easy_t *) userptr;
 	callback_t *cb = &easy->cb[ CB_EASY_SEEK ];
 
+	if ( !cb->func )
+		return easy->source
+			? perl_curl_source_seek( easy->source, &easy->source_cur,
+				offset, origin )
+			: CURL_SEEKFUNC_CANTSEEK;
+
 	SV *args[] = {
-		SELF2PERL( easy ),
+		perl_curl_easy_self( aTHX_ easy ),
 		newSViv( offset ),
 		newSViv( origin ),
 	};
@@ -325,7 +477,7 @@ cb_easy_sockopt( void *userptr, curl_socket_t curlfd, curlsocktype purpose )
 	callback_t *cb = &easy->cb[ CB_EASY_SOCKOPT ];
 
 	SV *args[] = {
-		SELF2PERL( easy ),
+		perl_curl_easy_self( aTHX_ easy ),
 		newSViv( curlfd ),
 		newSViv( purpose ),
 	};
@@ -350,7 +502,7 @@ cb_easy_opensocket( void *userptr, curlsocktype purpose,
 	HV *ah = NULL;
 
 	SV *args[] = {
-		SELF2PERL( easy ),
+		perl_curl_easy_self( aTHX_ easy ),
 		newSViv( purpose ),
 		&PL_sv_undef,
 	};
@@ -409,7 +561,7 @@ cb_easy_closesocket( void *userptr, curl_socket_t item )
 	callback_t *cb = &easy->cb[ CB_EASY_CLOSESOCKET ];
 
 	SV *args[] = {
-		SELF2PERL( easy ),
+		perl_curl_easy_self( aTHX_ easy ),
 		newSViv( item ),
 	};
 
@@ -431,16 +583,22 @@ cb_easy_interleave( void *ptr, size_t size, size_t nmemb, void *userptr )
 	callback_t *cb = &easy->cb[ CB_EASY_INTERLEAVE ];
 
 	if ( cb->func ) {
+		size_t ret;
 		SV *args[] = {
-			SELF2PERL( easy ),
+			perl_curl_easy_self( aTHX_ easy ),
 			&PL_sv_undef
 		};
 		if ( ptr )
-			args[1] = newSVpvn( ptr, (STRLEN) (size * nmemb) );
+			args[1] = perl_curl_easy_buffer( aTHX_ easy, ptr,
+				(STRLEN) (size * nmemb) );
 
-		return PERL_CURL_CALL( cb, args );
+		ret = PERL_CURL_CALL( cb, args );
+		perl_curl_easy_buffer_done( aTHX_ easy );
+
+		return ret;
 	} else {
-		return write_to_ctx( aTHX_ cb->data, ptr, size * nmemb );
+		return write_to_ctx( aTHX_ cb->data, easy->sink[ CB_EASY_INTERLEAVE ],
+			0, ptr, size * nmemb );
 	}
 }
 #endif
@@ -457,7 +615,7 @@ cb_easy_chunk_bgn( const void *transfer_info, void *userptr, int remains )
 	callback_t *cb = &easy->cb[ CB_EASY_CHUNK_BGN ];
 
 	SV *args[] = {
-		SELF2PERL( easy ),
+		perl_curl_easy_self( aTHX_ easy ),
 		&PL_sv_undef,
 		newSViv( remains )
 	};
@@ -535,7 +693,7 @@ cb_easy_chunk_end( void *userptr )
 	callback_t *cb = &easy->cb[ CB_EASY_CHUNK_END ];
 
 	SV *args[] = {
-		SELF2PERL( easy ),
+		perl_curl_easy_self( aTHX_ easy ),
 	};
 
 	return PERL_CURL_CALL( cb, args );
@@ -555,7 +713,7 @@ cb_easy_fnmatch( void *userptr, const char *pattern, const char *string )
 	callback_t *cb = &easy->cb[ CB_EASY_FNMATCH ];
 
 	SV *args[] = {
-		SELF2PERL( easy ),
+		perl_curl_easy_self( aTHX_ easy ),
 		newSVpv( pattern, 0 ),
 		newSVpv( string, 0 ),
 	};
@@ -595,7 +753,7 @@ cb_easy_sshkey( CURL *easy_handle, const struct curl_khkey *knownkey,
 	callback_t *cb = &easy->cb[ CB_EASY_SSHKEY ];
 
 	SV *args[] = {
-		SELF2PERL( easy ),
+		perl_curl_easy_self( aTHX_ easy ),
 		perl_curl_khkey2hash( aTHX_ knownkey ),
 		perl_curl_khkey2hash( aTHX_ foundkey ),
 		newSViv( khmatch ),
@@ -7,6 +7,14 @@
  */
 
 
+/* remember verbose mode wanted by perl, trace() needs it on */
+static long
+perl_curl_easy_verbose( perl_curl_easy_t *easy, long value )
+{
+	easy->verbose = value;
+	return easy->trace ? 1L : value;
+}
+
 static void
 perl_curl_easy_setopt_long( pTHX_ perl_curl_easy_t *easy, long option,
 		SV *value )
@@ -16,11 +24,58 @@ perl_curl_easy_setopt_long( pTHX_ perl_curl_easy_t *easy, long option,
 	if ( SvOK( value ) )
 		value_num = (long) SvIV( value );
 
+	if ( option == CURLOPT_VERBOSE )
+		value_num = perl_curl_easy_verbose( easy, value_num );
+
 	ret = curl_easy_setopt( easy->handle, option, value_num );
 	EASY_DIE( ret );
 }
 
 
+/*
+ * Read uploaded data natively if READDATA allows it. A perl READFUNCTION
+ * gets READDATA as is, so there is no source then.
+ */
+static CURLcode
+perl_curl_easy_source_hook( pTHX_ perl_curl_easy_t *easy )
+{
+	SV *sv = NULL;
+	int had_source = easy->source != NULL;
+
+	if ( !easy->cb[ CB_EASY_READ ].func )
+		sv = perl_curl_source_from_readdata( aTHX_
+			easy->cb[ CB_EASY_READ ].data );
+
+	SvREPLACE( easy->source_sv, sv );
+	easy->source = sv ? perl_curl_getptr( aTHX_ sv, &perl_curl_source_vtbl )
+		: NULL;
+
+#ifdef CURLOPT_SEEKFUNCTION
+	/* perl callback takes precedence */
+	if ( !easy->cb[ CB_EASY_SEEK ].func ) {
+		curl_easy_setopt( easy->handle, CURLOPT_SEEKFUNCTION,
+			easy->source ? cb_easy_seek : NULL );
+		curl_easy_setopt( easy->handle, CURLOPT_SEEKDATA,
+			easy->source ? easy : NULL );
+	}
+#endif
+
+	/* size came from the source, length is unknown again */
+	if ( !easy->source )
+		return had_source ? curl_easy_setopt( easy->handle,
+			CURLOPT_INFILESIZE_LARGE, (curl_off_t) -1 ) : CURLE_OK;
+
+#ifdef CURLOPT_UPLOAD_BUFFERSIZE
+	/* fewer and larger reads from files */
+	if ( easy->source->type == SOURCE_FD )
+		curl_easy_setopt( easy->handle, CURLOPT_UPLOAD_BUFFERSIZE,
+			(long) SOURCE_FD_BUFSIZE );
+#endif
+
+	return curl_easy_setopt( easy->handle, CURLOPT_INFILESIZE_LARGE,
+		(curl_off_t) easy->source->size );
+}
+
 static void
 perl_curl_easy_setopt_function( pTHX_ perl_curl_easy_t *easy, long option,
 		SV *value )
@@ -150,8 +205,13 @@ perl_curl_easy_setopt_function( pTHX_ perl_curl_easy_t *easy, long option,
 			croak( "unrecognized function option %ld", option );
 	}
 
-	if ( cbnum != CB_EASY_LAST )
+	if ( cbnum != CB_EASY_LAST ) {
 		SvREPLACE( easy->cb[ cbnum ].func, value );
+		CALLBACK_RESET( easy->cb[ cbnum ] );
+	}
+
+	if ( option == CURLOPT_READFUNCTION )
+		EASY_DIE( perl_curl_easy_source_hook( aTHX_ easy ) );
 
 	if ( dataopt ) {
 		CURLcode ret1, ret2;
@@ -160,6 +220,13 @@ perl_curl_easy_setopt_function( pTHX_ perl_curl_easy_t *easy, long option,
 		ret2 = curl_easy_setopt( easy->handle, dataopt,
 			SvOK( value ) ? easy : NULL );
 
+		if ( option == CURLOPT_HEADERFUNCTION && !SvOK( value ) )
+			perl_curl_easy_headers_hook( easy );
+		if ( dataopt == CURLOPT_PROGRESSDATA )
+			perl_curl_easy_progress_hook( easy );
+		if ( option == CURLOPT_DEBUGFUNCTION && !SvOK( value ) )
+			perl_curl_easy_trace_hook( easy );
+
 		EASY_DIE( ret1 ? ret1 : ret2 );
 	}
 }
@@ -189,6 +256,8 @@ perl_curl_easy_setopt_functiondata( pTHX_ perl_curl_easy_t *easy, long option,
 					SvOK( value ) ? easy : NULL );
 				if ( ret == CURLE_OK )
 					ret = ret2;
+				if ( !SvOK( value ) )
+					perl_curl_easy_headers_hook( easy );
 			}
 			cbnum = CB_EASY_HEADER;
 			break;
@@ -267,6 +336,10 @@ perl_curl_easy_setopt_functiondata( pTHX_ perl_curl_easy_t *easy, long option,
 	}
 
 	SvREPLACE( easy->cb[ cbnum ].data, value );
+	easy->sink[ cbnum ] = perl_curl_getptr( aTHX_ value, &perl_curl_sink_vtbl );
+
+	if ( cbnum == CB_EASY_READ )
+		ret = perl_curl_easy_source_hook( aTHX_ easy );
 
 	return ret;
 }
@@ -383,6 +456,30 @@ perl_curl_easy_setopt_object( pTHX_ perl_curl_easy_t *easy, long option,
 			}
 			return;
 
+#ifdef PERL_CURL_MIME
+		case CURLOPT_MIMEPOST:
+			if ( SvOK( value ) ) {
+				perl_curl_mime_t *mime;
+				mime = perl_curl_getptr_fatal( aTHX_ value, &perl_curl_mime_vtbl,
+					"CURLOPT_MIMEPOST", "Net::Curl::Mime" );
+				if ( mime->attached )
+					croak( "mime object used as subparts cannot be posted" );
+
+				ret = curl_easy_setopt( easy->handle, option, mime->mime );
+				EASY_DIE( ret );
+				perl_curl_mime_post( aTHX_ value, 1 );
+				perl_curl_mime_post( aTHX_ easy->mime_sv, -1 );
+				SvREPLACE( easy->mime_sv, value );
+				easy->mime = mime;
+			} else {
+				curl_easy_setopt( easy->handle, option, NULL );
+				perl_curl_mime_post( aTHX_ easy->mime_sv, -1 );
+				SvREPLACE( easy->mime_sv, NULL );
+				easy->mime = NULL;
+			}
+			return;
+#endif
+
 		case CURLOPT_SHARE:
 			if ( easy->share_sv ) {
 				curl_easy_setopt( easy->handle, option, NULL );
@@ -399,6 +496,7 @@ perl_curl_easy_setopt_object( pTHX_ perl_curl_easy_t *easy, long option,
 				easy->share_sv = newSVsv( value );
 				ret = curl_easy_setopt( easy->handle, option, share->handle );
 				EASY_DIE( ret );
+				perl_curl_share_apply( aTHX_ share, easy->handle );
 			}
 			return;
 
@@ -410,7 +508,7 @@ perl_curl_easy_setopt_object( pTHX_ perl_curl_easy_t *easy, long option,
 	/* default, assume it's data */
 	if ( SvOK( value ) ) {
 		char **ppv;
-		ppv = perl_curl_simplell_add( aTHX_ &easy->strings, option );
+		ppv = perl_curl_ptrhash_add( aTHX_ &easy->strings, option );
 		if ( ppv )
 			Safefree( *ppv );
 #ifdef savesvpv
@@ -423,7 +521,7 @@ perl_curl_easy_setopt_object( pTHX_ perl_curl_easy_t *easy, long option,
 		}
 #endif
 	} else {
-		pv = perl_curl_simplell_del( aTHX_ &easy->strings, option );
+		pv = perl_curl_ptrhash_del( aTHX_ &easy->strings, option );
 		if ( pv )
 			Safefree( pv );
 		pv = NULL;
@@ -435,12 +533,10 @@ perl_curl_easy_setopt_object( pTHX_ perl_curl_easy_t *easy, long option,
 
 
 
-static void
-perl_curl_easy_setopt_off_t( pTHX_ perl_curl_easy_t *easy, long option,
-		SV *value )
+/* this should be curl_off_t, but there is a bug in older curl - 7.18.2 */
+static long long
+perl_curl_sv2off_t( pTHX_ SV *value )
 {
-	CURLcode ret = CURLE_OK;
-	/* this should be curl_off_t, but there is a bug in older curl - 7.18.2 */
 	long long v = 0;
 
 	if ( SvOK( value ) ) {
@@ -457,6 +553,271 @@ perl_curl_easy_setopt_off_t( pTHX_ perl_curl_easy_t *easy, long option,
 		}
 	}
 
+	return v;
+}
+
+static void
+perl_curl_easy_setopt_off_t( pTHX_ perl_curl_easy_t *easy, long option,
+		SV *value )
+{
+	CURLcode ret = CURLE_OK;
+	long long v = perl_curl_sv2off_t( aTHX_ value );
+
 	ret = curl_easy_setopt( easy->handle, option, v );
 	EASY_DIE( ret );
 }
+
+static void
+perl_curl_easy_setopt_any( pTHX_ perl_curl_easy_t *easy, long option,
+		SV *value )
+{
+	int opttype = option - option % CURLOPTTYPE_OBJECTPOINT;
+
+	if ( opttype == CURLOPTTYPE_LONG ) {
+		perl_curl_easy_setopt_long( aTHX_ easy, option, value );
+	} else if ( opttype == CURLOPTTYPE_OBJECTPOINT ) {
+		perl_curl_easy_setopt_object( aTHX_ easy, option, value );
+	} else if ( opttype == CURLOPTTYPE_FUNCTIONPOINT ) {
+		perl_curl_easy_setopt_function( aTHX_ easy, option, value );
+	} else if ( opttype == CURLOPTTYPE_OFF_T ) {
+		perl_curl_easy_setopt_off_t( aTHX_ easy, option, value );
+#ifdef CURLOPTTYPE_BLOB
+	} else if ( opttype == CURLOPTTYPE_BLOB ) {
+		perl_curl_easy_setopt_blob( aTHX_ easy, option, value );
+#endif
+	} else {
+		perl_curl_croak_invalid_option(aTHX_ option);
+	}
+}
+
+
+/*
+ * Templates: options converted once, applied to many easy handles.
+ */
+typedef enum {
+	TEMPLATE_LONG,
+	TEMPLATE_OFF_T,
+	/* string option libcurl makes its own copy of */
+	TEMPLATE_STRING,
+	TEMPLATE_SLIST,
+	/* anything else goes through regular setopt */
+	TEMPLATE_SV,
+} perl_curl_template_kind_t;
+
+typedef struct {
+	long option;
+	perl_curl_template_kind_t kind;
+	union {
+		long l;
+		long long off;
+		char *str;
+		perl_curl_slist_t *slist;
+		SV *sv;
+	} value;
+} perl_curl_template_opt_t;
+
+struct perl_curl_template_s {
+	/* last seen perl object */
+	SV *perl_self;
+
+	perl_curl_template_opt_t *opts;
+	int count;
+};
+
+/* string options libcurl does not copy or we must handle ourselves */
+static int
+perl_curl_template_string_ok( long option )
+{
+	switch ( option ) {
+		case CURLOPT_POSTFIELDS:
+		case CURLOPT_ERRORBUFFER:
+		case CURLOPT_STDERR:
+		case CURLOPT_HTTPPOST:
+#ifdef PERL_CURL_MIME
+		case CURLOPT_MIMEPOST:
+#endif
+		case CURLOPT_SHARE:
+		case CURLOPT_PRIVATE:
+		case CURLOPT_FILE:
+		case CURLOPT_INFILE:
+		case CURLOPT_WRITEHEADER:
+		case CURLOPT_PROGRESSDATA:
+		case CURLOPT_DEBUGDATA:
+		case CURLOPT_IOCTLDATA:
+#ifdef CURLOPT_SEEKDATA
+		case CURLOPT_SEEKDATA:
+#endif
+#ifdef CURLOPT_SOCKOPTDATA
+		case CURLOPT_SOCKOPTDATA:
+#endif
+#ifdef CURLOPT_OPENSOCKETDATA
+		case CURLOPT_OPENSOCKETDATA:
+#endif
+#ifdef CURLOPT_CLOSESOCKETDATA
+		case CURLOPT_CLOSESOCKETDATA:
+#endif
+#ifdef CURLOPT_INTERLEAVEDATA
+		case CURLOPT_INTERLEAVEDATA:
+#endif
+#ifdef CURLOPT_CHUNK_DATA
+		case CURLOPT_CHUNK_DATA:
+#endif
+#ifdef CURLOPT_FNMATCH_DATA
+		case CURLOPT_FNMATCH_DATA:
+#endif
+#ifdef CURLOPT_SSH_KEYDATA
+		case CURLOPT_SSH_KEYDATA:
+#endif
+			return 0;
+	}
+	return 1;
+}
+
+static int
+perl_curl_option_is_slist( long option )
+{
+	int si;
+
+	for ( si = 0; si < perl_curl_easy_option_slist_num; si++ )
+		if ( perl_curl_easy_option_slist[ si ] == option )
+			return 1;
+	return 0;
+}
+
+/* validate and convert one option, croaks on invalid ones */
+static void
+perl_curl_template_add( pTHX_ perl_curl_template_t *tpl, long option,
+		SV *value )
+{
+	int opttype = option - option % CURLOPTTYPE_OBJECTPOINT;
+	perl_curl_template_opt_t *opt;
+
+	Renew( tpl->opts, tpl->count + 1, perl_curl_template_opt_t );
+	opt = &tpl->opts[ tpl->count ];
+	opt->option = option;
+
+	if ( opttype == CURLOPTTYPE_LONG ) {
+		opt->kind = TEMPLATE_LONG;
+		opt->value.l = SvOK( value ) ? (long) SvIV( value ) : 0;
+	} else if ( opttype == CURLOPTTYPE_OFF_T ) {
+		opt->kind = TEMPLATE_OFF_T;
+		opt->value.off = perl_curl_sv2off_t( aTHX_ value );
+	} else if ( opttype == CURLOPTTYPE_OBJECTPOINT
+			&& perl_curl_option_is_slist( option ) ) {
+		opt->kind = TEMPLATE_SLIST;
+		opt->value.slist = perl_curl_slist_from_sv( aTHX_ value );
+#if LIBCURL_VERSION_NUM >= 0x071100
+	/* since 7.17.0 libcurl copies strings, we can pass our own copy */
+	} else if ( opttype == CURLOPTTYPE_OBJECTPOINT && SvOK( value )
+			&& !SvROK( value ) && SvTYPE( value ) != SVt_PVGV
+			&& perl_curl_template_string_ok( option ) ) {
+		STRLEN len;
+		char *src = SvPV( value, len );
+		opt->kind = TEMPLATE_STRING;
+		opt->value.str = savepvn( src, len );
+#endif
+	} else if ( opttype == CURLOPTTYPE_OBJECTPOINT
+			|| opttype == CURLOPTTYPE_FUNCTIONPOINT
+#ifdef CURLOPTTYPE_BLOB
+			|| opttype == CURLOPTTYPE_BLOB
+#endif
+			) {
+		opt->kind = TEMPLATE_SV;
+		opt->value.sv = newSVsv( value );
+	} else {
+		perl_curl_croak_invalid_option( aTHX_ option );
+	}
+
+	tpl->count++;
+}
+
+static void
+perl_curl_template_apply( pTHX_ perl_curl_template_t *tpl,
+		perl_curl_easy_t *easy )
+{
+	int i;
+
+	for ( i = 0; i < tpl->count; i++ ) {
+		perl_curl_template_opt_t *opt = &tpl->opts[ i ];
+		CURLcode ret = CURLE_OK;
+
+		switch ( opt->kind ) {
+			case TEMPLATE_LONG:
+				ret = curl_easy_setopt( easy->handle, opt->option,
+					opt->option == CURLOPT_VERBOSE
+						? perl_curl_easy_verbose( easy, opt->value.l )
+						: opt->value.l );
+				break;
+			case TEMPLATE_OFF_T:
+				ret = curl_easy_setopt( easy->handle, opt->option,
+					opt->value.off );
+				break;
+			case TEMPLATE_STRING:
+			{
+				/* curl makes a copy, we do not need ours anymore */
+				char *pv = perl_curl_ptrhash_del( aTHX_ &easy->strings,
+					opt->option );
+				if ( pv )
+					Safefree( pv );
+				/* except for URL, Multi enqueue() takes host from it */
+				if ( opt->option == CURLOPT_URL )
+					*(char **) perl_curl_ptrhash_add( aTHX_ &easy->strings,
+						opt->option ) = savepv( opt->value.str );
+				ret = curl_easy_setopt( easy->handle, opt->option,
+					opt->value.str );
+				break;
+			}
+			case TEMPLATE_SLIST:
+			{
+				perl_curl_slist_t **pslist;
+				pslist = perl_curl_ptrhash_add( aTHX_ &easy->slists,
+					opt->option );
+				if ( *pslist )
+					perl_curl_slist_unref( *pslist );
+				*pslist = perl_curl_slist_ref( opt->value.slist );
+				ret = curl_easy_setopt( easy->handle, opt->option,
+					opt->value.slist->list );
+				break;
+			}
+			case TEMPLATE_SV:
+				perl_curl_easy_setopt_any( aTHX_ easy, opt->option,
+					opt->value.sv );
+				break;
+		}
+		EASY_DIE( ret );
+	}
+}
+
+static int
+perl_curl_template_magic_free( pTHX_ SV *sv, MAGIC *mg )
+{
+	perl_curl_template_t *tpl = (perl_curl_template_t *) mg->mg_ptr;
+	int i;
+
+	if ( !tpl )
+		return 0;
+
+	for ( i = 0; i < tpl->count; i++ ) {
+		perl_curl_template_opt_t *opt = &tpl->opts[ i ];
+		if ( opt->kind == TEMPLATE_STRING )
+			Safefree( opt->value.str );
+		else if ( opt->kind == TEMPLATE_SLIST )
+			perl_curl_slist_unref( opt->value.slist );
+		else if ( opt->kind == TEMPLATE_SV )
+			sv_2mortal( opt->value.sv );
+	}
+	Safefree( tpl->opts );
+	Safefree( tpl );
+
+	return 0;
+}
+
+static MGVTBL perl_curl_template_vtbl = {
+	NULL, NULL, NULL, NULL
+	,perl_curl_template_magic_free
+	,NULL
+	,perl_curl_any_magic_nodup
+#ifdef MGf_LOCAL
+	,NULL
+#endif
+};
@@ -0,0 +1,68 @@
+#!perl
+#
+# Measures cost of a single write and progress callback call against
+# a local http server, for code references and method names.
+#
+#  perl -Mblib bench/callback-dispatch.pl [SIZE_MB] [ROUNDS]
+#
+# CURLOPT_BUFFERSIZE is set to its minimum, so there are as many write
+# callback calls as possible. Reported time includes libcurl overhead.
+#
+use strict;
+use warnings;
+use lib 'inc';
+use Time::HiRes qw(time);
+use Test::HTTP::Server;
+use Net::Curl::Easy qw(:constants);
+
+my $size_mb = shift || 16;
+my $rounds = shift || 5;
+
+local $ENV{no_proxy} = '*';
+my $server = Test::HTTP::Server->new;
+my $url = $server->uri . "repeat/" . ( $size_mb * 1024 * 1024 ) . "/x";
+
+package Bench::Easy;
+our @ISA = qw(Net::Curl::Easy);
+
+my $calls;
+sub on_write { $calls++; return length $_[1] }
+sub on_progress { $calls++; return 0 }
+
+package main;
+
+sub run
+{
+	my ( $option, $func ) = @_;
+	my $easy = Bench::Easy->new();
+	$easy->setopt( CURLOPT_URL, $url );
+	$easy->setopt( CURLOPT_BUFFERSIZE, 1024 );
+	$easy->setopt( CURLOPT_FILE, \my $body ) if $option != CURLOPT_WRITEFUNCTION;
+	$easy->setopt( CURLOPT_NOPROGRESS, 0 ) if $option != CURLOPT_WRITEFUNCTION;
+	$easy->setopt( $option, $func );
+	$easy->setopt( $option == CURLOPT_WRITEFUNCTION
+		? CURLOPT_FILE : CURLOPT_PROGRESSDATA, { user => "data" } );
+
+	my $best;
+	foreach ( 1 .. $rounds ) {
+		$calls = 0;
+		my $start = time;
+		$easy->perform();
+		my $ns = ( time - $start ) * 1e9 / ( $calls || 1 );
+		$best = $ns if not defined $best or $ns < $best;
+	}
+	return ( $best, $calls );
+}
+
+my $xferinfo = eval { CURLOPT_XFERINFOFUNCTION() } || CURLOPT_PROGRESSFUNCTION;
+
+printf "%-24s %10s %10s\n", "callback", "ns/call", "calls";
+foreach (
+		[ "write, code ref", CURLOPT_WRITEFUNCTION, \&Bench::Easy::on_write ],
+		[ "write, method", CURLOPT_WRITEFUNCTION, "on_write" ],
+		[ "progress, code ref", $xferinfo, \&Bench::Easy::on_progress ],
+		[ "progress, method", $xferinfo, "on_progress" ],
+	) {
+	my ( $name, @args ) = @$_;
+	printf "%-24s %10.0f %10d\n", $name, run( @args );
+}
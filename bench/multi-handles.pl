@@ -0,0 +1,40 @@
+#!perl
+#
+# Measures add_handle/remove_handle churn on a single multi handle and checks that total time grows linearly with number of handles.
+#
+#  perl -Mblib bench/multi-handles.pl [HANDLES]
+#
+# Runs with HANDLES / 4 and HANDLES, exits with an error if the larger run
+# is more than 8 times slower (linear is 4, quadratic would be 16).
+#
+use strict;
+use warnings;
+use Time::HiRes qw(time);
+use Net::Curl::Easy;
+use Net::Curl::Multi;
+
+my $handles = shift || 100_000;
+
+sub run
+{
+	my $n = shift;
+	my $multi = Net::Curl::Multi->new();
+	my @easy = map { Net::Curl::Easy->new() } 1 .. $n;
+
+	my $start = time;
+	$multi->add_handle( $_ ) foreach @easy;
+	# remove every other handle first, then the rest
+	$multi->remove_handle( $easy[ $_ * 2 ] ) foreach 0 .. $n / 2 - 1;
+	$multi->remove_handle( $easy[ $_ * 2 + 1 ] ) foreach 0 .. $n / 2 - 1;
+
+	return time - $start;
+}
+
+my $small = run( int( $handles / 4 ) );
+my $large = run( $handles );
+my $ratio = $large / ( $small || 1e-6 );
+
+printf "%10s %10s %8s\n", $handles / 4, $handles, "ratio";
+printf "%9.3fs %9.3fs %8.2f\n", $small, $large, $ratio;
+
+die "time does not grow linearly with number of handles\n" if $ratio > 8;
@@ -0,0 +1,78 @@
+#!perl
+#
+# Measures how Net::Curl::Share locking scales with the number of threads.
+# Based on examples/04-share-threads.pl, but without the whole-share
+# semaphore: each thread runs its own transfers against a local server,
+# with DNS cache, cookies and connections shared between all of them.
+#
+#  perl -Mblib bench/share-threads.pl [TRANSFERS] [MAX_THREADS] [SPIN]
+#
+# Prints transfers per second and lock statistics for 1, 2, 4, ...
+# MAX_THREADS threads doing TRANSFERS transfers in total.
+#
+use strict;
+use warnings;
+use Config;
+use threads;
+use Time::HiRes qw(time);
+use lib 'inc';
+use Test::HTTP::Server;
+use Net::Curl::Easy qw(:constants);
+use Net::Curl::Share qw(:constants);
+
+die "perl is not built with ithreads\n" unless $Config{useithreads};
+
+my $transfers = shift || 2000;
+my $max_threads = shift || 32;
+my $spin = shift || 0;
+
+# threads must not inherit the server, it would be killed when they exit
+sub Test::HTTP::Server::CLONE_SKIP { 1 }
+
+my $server = Test::HTTP::Server->new or die "Could not run http server\n";
+my $uri = $server->uri . "cookie/3";
+
+my %names = (
+	CURL_LOCK_DATA_SHARE() => "share",
+	CURL_LOCK_DATA_COOKIE() => "cookie",
+	CURL_LOCK_DATA_DNS() => "dns",
+	CURL_LOCK_DATA_CONNECT() => "connect",
+);
+
+sub worker
+{
+	my ( $share, $n ) = @_;
+	foreach ( 1 .. $n ) {
+		my $easy = Net::Curl::Easy->new();
+		$easy->setopt( CURLOPT_URL, $uri );
+		$easy->setopt( CURLOPT_SHARE, $share );
+		$easy->setopt( CURLOPT_COOKIEFILE, "" );
+		$easy->setopt( CURLOPT_WRITEDATA, \my $body );
+		$easy->perform();
+	}
+	return;
+}
+
+printf "%7s %10s  %s\n", "threads", "req/s", "lock: shared/single contended wait";
+for ( my $threads = 1; $threads <= $max_threads; $threads *= 2 ) {
+	my $share = Net::Curl::Share->new();
+	$share->setopt( CURLSHOPT_SHARE, $_ )
+		foreach CURL_LOCK_DATA_COOKIE, CURL_LOCK_DATA_DNS;
+	$share->lock_spin( $spin );
+
+	my $start = time;
+	$_->join() foreach
+		map { threads->create( \&worker, $share, $transfers / $threads ) }
+		1 .. $threads;
+	my $elapsed = time - $start;
+
+	my $stats = $share->lock_stats();
+	my @locks = map {
+		my ( $shared, $single, $contended, $wait ) = @{ $stats->{ $_ } };
+		sprintf "%s: %d/%d %d %.3fs", $names{ $_ } || $_,
+			$shared, $single, $contended, $wait;
+	} sort { $a <=> $b } keys %$stats;
+
+	printf "%7d %10.1f  %s\n", $threads, $transfers / $elapsed,
+		join "; ", @locks;
+}
@@ -0,0 +1,52 @@
+#!perl
+#
+# Measures CURLOPT_WRITEFUNCTION throughput against a local http server,
+# with and without buffer_reuse.
+#
+#  perl -Mblib bench/write-callback.pl [SIZE_MB] [ROUNDS] [BUFFERSIZE]
+#
+# Smaller BUFFERSIZE means more callback calls per megabyte.
+#
+use strict;
+use warnings;
+use lib 'inc';
+use Time::HiRes qw(time);
+use Test::HTTP::Server;
+use Net::Curl::Easy qw(:constants);
+
+my $size_mb = shift || 64;
+my $rounds = shift || 5;
+my $buffersize = shift || 16384;
+
+local $ENV{no_proxy} = '*';
+my $server = Test::HTTP::Server->new;
+my $url = $server->uri . "repeat/" . ( $size_mb * 1024 * 1024 ) . "/x";
+
+sub run
+{
+	my $reuse = shift;
+	my $easy = Net::Curl::Easy->new();
+	$easy->setopt( CURLOPT_URL, $url );
+	$easy->setopt( CURLOPT_BUFFERSIZE, $buffersize );
+	$easy->buffer_reuse( $reuse );
+
+	my $bytes = 0;
+	$easy->setopt( CURLOPT_WRITEFUNCTION, sub {
+		$bytes += length $_[1];
+		return length $_[1];
+	} );
+
+	my $best = 0;
+	foreach ( 1 .. $rounds ) {
+		$bytes = 0;
+		my $start = time;
+		$easy->perform();
+		my $mbs = $bytes / ( 1024 * 1024 ) / ( time - $start );
+		$best = $mbs if $mbs > $best;
+	}
+	return $best;
+}
+
+printf "%-16s %10s\n", "mode", "MB/s";
+printf "%-16s %10.1f\n", "new scalar", run( 0 );
+printf "%-16s %10.1f\n", "buffer_reuse", run( 1 );
@@ -102,7 +102,8 @@ Calls L<curl_easy_init(3)|https://curl.haxx.se/libcurl/c/curl_easy_init.html> an
 =item duphandle( [BASE] )
 
 Clone Net::Curl::Easy object. It will not copy BASE from the source object.
-If you want it copied you must do it on your own.
+If you want it copied you must do it on your own. String lists are shared
+with the source object, not copied.
 
  my $hash_clone = $easy->duphandle( { %$easy } );
 
@@ -114,7 +115,9 @@ Calls L<curl_easy_duphandle(3)|https://curl.haxx.se/libcurl/c/curl_easy_duphandl
 =item setopt( OPTION, VALUE )
 
 Set an option. OPTION is a numeric value, use one of CURLOPT_* constants.
-VALUE depends on whatever that option expects.
+VALUE depends on whatever that option expects. Options which expect a list
+of strings take an array reference or a L<Net::Curl::Slist> object, which
+is shared without copying.
 
  $easy->setopt( Net::Curl::Easy::CURLOPT_URL, $uri );
 
@@ -128,6 +131,9 @@ replacing the old slist.
  $easy->pushopt( Net::Curl::Easy::CURLOPT_HTTPHEADER,
      ['More: headers'] );
 
+ARRAYREF may also be a L<Net::Curl::Slist> object. A list shared with other
+handles is copied before appending, so they are not affected.
+
 Builds a slist and calls L<curl_easy_setopt(3)|https://curl.haxx.se/libcurl/c/curl_easy_setopt.html>.
 Throws L</Net::Curl::Easy::Code> on error.
 
@@ -160,6 +166,41 @@ Throws L</Net::Curl::Easy::Code> on error.
 In the case of C<CURLINFO_CERTINFO>, the return is an array reference of
 hash references; each hash represents one certificate.
 
+C<CURLINFO_*_T> options (libcurl 7.55.0+) return integers, times in
+microseconds. Socket options return -1 if there is no socket.
+
+=item getinfo_multi( OPTION, ... )
+
+Retrieve several values at once, returns them in the same order as
+options. Values are the same as those returned by getinfo().
+
+ my ( $code, $ttfb, $size ) = $easy->getinfo_multi(
+     CURLINFO_RESPONSE_CODE,
+     CURLINFO_STARTTRANSFER_TIME_T,
+     CURLINFO_SIZE_DOWNLOAD_T,
+ );
+
+Throws L</Net::Curl::Easy::Code> on error.
+
+There is no libcurl equivalent.
+
+=item stats( )
+
+Returns a hash reference with timings and counters of last transfer,
+collected in a single call. All values are integers. Times are in
+microseconds: namelookup, connect, appconnect, pretransfer, starttransfer,
+total and redirect. Counters: size_download, size_upload, speed_download,
+speed_upload, header_size, request_size, response_code, num_connects and
+redirect_count. Values libcurl cannot provide are left out.
+
+ my $stats = $easy->stats();
+ printf "ttfb: %.3f ms\n", $stats->{starttransfer} / 1000;
+
+With libcurl older than 7.61.0 times are converted from CURLINFO_*_TIME
+floating point values.
+
+There is no libcurl equivalent.
+
 =item pause( )
 
 Pause the transfer.
@@ -196,6 +237,150 @@ a longer description.
  my $error = $easy->error();
  print "Last error: $error\n";
 
+=item buffer_reuse( [ENABLE] )
+
+If enabled, write, header and interleave callbacks receive a read-only
+scalar which points directly at libcurl buffer instead of a new copy of the
+data. The same scalar is reused for every call, so there is no allocation
+nor copying per chunk. Returns previous setting.
+
+ $easy->buffer_reuse( 1 );
+ $easy->setopt( CURLOPT_WRITEFUNCTION, sub {
+     my ( $easy, $data, $uservar ) = @_;
+     $digest->add( $data );
+     return length $data;
+ } );
+
+Copying the data out (C<my $copy = $data>) works as usual. If callback
+keeps a reference to the data scalar itself, that scalar receives its own
+copy of the data after the callback returns.
+
+There is no libcurl equivalent.
+
+=item max_body_bytes( [BYTES] )
+
+Get or set maximum size of response body, 0 (default) means no limit.
+Returns previous value. If the server advertises a larger Content-Length
+or more data arrives, transfer is aborted and perform() throws
+CURLE_WRITE_ERROR. The limit applies to all write destinations, including
+write callbacks and L<Net::Curl::Sink> objects.
+
+ $easy->max_body_bytes( 16 * 1024 * 1024 );
+
+There is no libcurl equivalent.
+
+=item collect_headers( [ENABLE] )
+
+If enabled, header lines of each response are stored by C code in a single
+buffer, and can be queried with headers() after the transfer. Only headers
+of the last response are kept: a redirect or a C<100 Continue> status line
+starts a new set. Collecting works along with any header callback or
+CURLOPT_WRITEHEADER destination. Returns previous setting.
+
+ $easy->collect_headers( 1 );
+ $easy->perform();
+ my $type = $easy->headers( "Content-Type" );
+
+There is no libcurl equivalent.
+
+=item headers( [NAME] )
+
+Without arguments returns all collected headers as a list of name and value
+pairs, in order of arrival, with names as sent by the server. With NAME
+returns all values of that header in list context, or the first one in
+scalar context. Names are compared without regard to case.
+
+ my @cookies = $easy->headers( "Set-Cookie" );
+ my %headers = $easy->headers();
+
+Lines are split into names and values, and a hashed index of names is
+built, on first lookup after the transfer, not while data is received.
+Dies if collect_headers() is not enabled.
+
+=item progress_policy( [KEY => VALUE, ...] )
+
+Sets progress throttling and abort policies evaluated by C code on every
+libcurl progress tick, replacing previous ones. Without arguments removes
+all policies. Zero disables any of them.
+
+=over
+
+=item interval_ms, bytes
+
+Call perl progress (or xferinfo) callback only if that many milliseconds
+passed, or that many bytes were transferred, since the last call. If
+both are set the callback is called when either is reached.
+
+=item max_bytes
+
+Abort the transfer if more bytes were transferred, or are announced to be
+transferred, in both directions together.
+
+=item min_speed, window_ms
+
+Abort the transfer if average speed in any complete window of window_ms
+milliseconds (10000 by default) is lower than min_speed bytes per
+second. The first window starts when the first byte is sent or received,
+so time spent resolving, connecting and in the TLS handshake is not
+counted. A server which never sends or accepts a single byte is not
+caught by this policy; use deadline or CURLOPT_TIMEOUT_MS for that.
+
+=item deadline
+
+Abort the transfer if it is still running at that time, given in epoch
+seconds, fractions allowed.
+
+=back
+
+An aborted transfer fails with CURLE_ABORTED_BY_CALLBACK. Policies work
+without any perl callback: a native one is installed and
+CURLOPT_NOPROGRESS is cleared. Do not set CURLOPT_NOPROGRESS again
+while policies are in use.
+
+ $easy->progress_policy(
+     interval_ms => 250,
+     max_bytes => 100 * 1024 * 1024,
+     deadline => time + 30,
+ );
+
+There is no libcurl equivalent.
+
+=item progress_stats( )
+
+Returns a hash reference with number of progress C<ticks> seen during the
+last transfer, how many of them were C<delivered> to perl, and the policy
+which C<aborted> the transfer, if any: "max_bytes", "min_speed" or
+"deadline". Returns undef if there are no progress policies.
+
+=item trace( [SIZE], [SNAPLEN] )
+
+Starts recording debug events in a ring of SIZE entries, each keeping up to
+SNAPLEN (256 by default) bytes of data. When the ring is full the oldest
+event is overwritten. Events are recorded by C code, no perl scalars are
+created and nothing is allocated while transfers run. Without SIZE, or with
+0, stops recording and drops recorded events.
+
+CURLOPT_VERBOSE is enabled and a native debug callback is installed, so
+libcurl does not print verbose information to stderr anymore. A perl
+CURLOPT_DEBUGFUNCTION, if set, is still called for every event. Once
+recording stops CURLOPT_VERBOSE goes back to the value last set with
+setopt(), 0 by default.
+
+ $easy->trace( 200 );
+ eval { $easy->perform() };
+ if ( $@ ) {
+     warn "$_->[1]: $_->[2]" for $easy->trace_dump;
+ }
+
+There is no libcurl equivalent.
+
+=item trace_dump( [CLEAR] )
+
+Returns recorded events, oldest first. Each one is an array reference of
+time (epoch seconds, fractional), CURLINFO_* type, data truncated to
+SNAPLEN bytes and original length of the data. If CLEAR is true recorded
+events are removed afterwards. Dies if trace() is not enabled.
+
 =item multi( )
 
 If easy object is associated with any multi handles, it will return that
@@ -293,6 +478,14 @@ Callbacks can be set using setopt() method.
  $easy->setopt( CURLOPT_somethingDATA, [qw(any additional data
      you want)] );
 
+Method name callbacks are looked up in the package of the easy object once
+and looked up again only if methods of that package, or of its parents,
+change. The data value is passed to the callback as is, not copied, and
+is read-only while the callback runs: assigning to C<$_[-1]> dies (and
+the callback fails like any other dying callback). Data reached through
+a reference, like the array above, can be changed as usual. Before 0.58
+the callback received a copy and such assignments were silently lost.
+
 =over
 
 =item CURLOPT_WRITEFUNCTION ( CURLOPT_WRITEDATA )
@@ -307,6 +500,11 @@ CURLOPT_WRITEDATA was set to. It must return number of data bytes.
      return length $data;
  }
 
+If no write function is set, CURLOPT_WRITEDATA may also be a scalar reference,
+a file handle or a L<Net::Curl::Sink> object. Data written to a sink never
+enters perl code. A scalar is preallocated to the size advertised in
+Content-Length (up to 1GiB) before the first write.
+
 =item CURLOPT_READFUNCTION ( CURLOPT_READDATA )
 
 read callback receives 3 arguments: easy object, maximum data length, and
@@ -321,6 +519,18 @@ is zero in length ("", undef) will also signalize completed transfer.
      return \$data;
  }
 
+If there is no read callback, CURLOPT_READDATA may be a file handle,
+a L<Net::Curl::Source> object, or a scalar or array reference, which is
+converted to a source. Data from sources is sent without calling any
+perl code.
+
+A scalar or array reference is copied into the source by setopt(), like
+L<Net::Curl::Source/buffer> does; changes made to the referenced data
+afterwards are not uploaded until CURLOPT_READDATA is set again. Setting
+CURLOPT_READFUNCTION, before or after READDATA, disables the conversion
+and the callback receives the reference as is. Before 0.58 references
+were not converted and could not be used without a read callback.
+
 =item CURLOPT_IOCTLFUNCTION ( CURLOPT_IOCTLDATA )
 
 ioctl callback receives 3 arguments: easy object, ioctl command, and
@@ -517,6 +727,113 @@ Must return one of CURLKHSTAT_* values.
 
 =back
 
+=head2 Net::Curl::Easy::Pool
+
+Keeps idle easy handles for reuse, so a busy client does not create and
+destroy a handle for every request. A returned handle is reset to the
+state of a new one, but libcurl keeps its open connections and DNS cache,
+and an attached L<Net::Curl::Share> stays attached. There is no libcurl
+equivalent.
+
+ my $pool = Net::Curl::Easy::Pool->new( 64, $template );
+
+ my $easy = $pool->get();
+ $easy->setopt( CURLOPT_URL, $uri );
+ $easy->perform();
+ $pool->put( $easy );
+
+=over
+
+=item new( [MAX], [TEMPLATE], [CLASS] )
+
+Creates a pool which keeps at most MAX (16 by default) idle handles. If
+L</Net::Curl::Easy::Template> TEMPLATE is given it is applied to every new
+and every returned handle, before it is handed out. New handles are
+blessed into CLASS, Net::Curl::Easy or a subclass of it (Net::Curl::Easy
+by default). The constructor of CLASS is not called.
+
+ my $pool = Net::Curl::Easy::Pool->new( 64, undef, "My::Easy" );
+
+=item get( )
+
+Returns an idle handle, or a new object of the pool's CLASS if there are
+none.
+
+=item put( EASY )
+
+Returns EASY to the pool. All options and callbacks are reset, as with
+L<curl_easy_reset(3)|https://curl.haxx.se/libcurl/c/curl_easy_reset.html>,
+and the base hash is emptied: every key stored in the object, like
+C<< $easy->{id} >>, is deleted. The class of the object is kept.
+
+The pool takes the handle away: EASY must be the only reference to the
+object, and the variable passed as EASY is set to undef once the handle
+is in the pool.
+
+ $pool->put( $easy );   # $easy is undef now
+
+Returns false if the pool is full, EASY is left untouched then. Dies if
+EASY is referenced anywhere else, is still attached to or queued in a
+multi handle, is running in an executor, or is in a pool already.
+
+=item count( )
+
+Returns number of idle handles.
+
+=item max( [MAX] )
+
+Returns maximum number of idle handles, sets new value if MAX is specified.
+Handles over the limit are destroyed.
+
+=item stats( )
+
+Returns a hash reference with number of handles C<created>, C<reused>
+and currently C<idle>.
+
+=back
+
+=head2 Net::Curl::Easy::Template
+
+A frozen set of options, converted once and applied to any number of easy
+handles in a single call. Numbers are converted, strings copied and slists
+built when the template is created. Applied slists are shared with the
+template, pushopt() on a handle makes its own copy before appending.
+L<Net::Curl::Slist> objects given as values are shared as they are.
+Callbacks and other options which need per-handle data are stored and set
+with setopt() on every apply(). There is no libcurl equivalent.
+
+ my $tpl = Net::Curl::Easy::Template->new(
+     CURLOPT_USERAGENT, "my-crawler/1.0",
+     CURLOPT_TIMEOUT_MS, 5000,
+     CURLOPT_FOLLOWLOCATION, 1,
+     CURLOPT_HTTPHEADER, [ "Accept: text/html" ],
+ );
+
+ foreach my $uri ( @uris ) {
+     my $easy = Net::Curl::Easy->new();
+     $tpl->apply( $easy );
+     $easy->setopt( CURLOPT_URL, $uri );
+     ...
+ }
+
+=over
+
+=item new( OPTION, VALUE, ... )
+
+Creates a template from option and value pairs. Dies if any option is
+invalid.
+
+=item apply( EASY, ... )
+
+Sets all options on each of the easy handles, in the order they were given
+to new(). Throws L</Net::Curl::Easy::Code> on error.
+
+=item count( )
+
+Returns number of options in the template.
+
+=back
+
 =head2 Net::Curl::Easy::Code
 
 Most Net::Curl::Easy methods on failure throw a Net::Curl::Easy::Code error
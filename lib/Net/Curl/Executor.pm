@@ -0,0 +1,159 @@
+package Net::Curl::Executor;
+use strict;
+use warnings;
+
+use Net::Curl ();
+
+our $VERSION = '0.57';
+
+1;
+
+__END__
+
+=head1 NAME
+
+Net::Curl::Executor - Transfers performed by native threads
+
+=head1 SYNOPSIS
+
+ use Net::Curl::Easy qw(:constants);
+ use Net::Curl::Executor;
+ use Net::Curl::Sink;
+
+ my $executor = Net::Curl::Executor->new( 8 );
+
+ foreach my $n ( 1 .. 100 ) {
+     my $easy = Net::Curl::Easy->new( { n => $n } );
+     $easy->setopt( CURLOPT_URL, "http://example.com/part$n" );
+     $easy->setopt( CURLOPT_WRITEDATA, Net::Curl::Sink->mmap( "part$n" ) );
+     $executor->submit( $easy );
+ }
+
+ while ( $executor->pending ) {
+     $executor->wait();
+     my @done = $executor->harvest();
+     while ( my ( $easy, $result ) = splice @done, 0, 2 ) {
+         warn "part $easy->{n} failed: $result\n" if $result;
+     }
+ }
+
+=head1 DESCRIPTION
+
+Easy handles cannot be used in other perl threads, so all transfers of
+a process are normally driven by a single core. Executor runs a pool of
+native threads, each with its own multi handle, and performs submitted
+easy handles there. Worker threads never enter perl, which is why only
+handles which do not need perl are accepted:
+
+=over
+
+=item *
+
+no perl callbacks of any kind are set,
+
+=item *
+
+CURLOPT_WRITEDATA and CURLOPT_HEADERDATA are L<Net::Curl::Sink> fd or mmap
+sinks, or are not set at all (data is discarded then), and no other
+submitted handle writes to the same sink (a duphandle() copy shares its
+sinks),
+
+=item *
+
+CURLOPT_READDATA, if set, is a native L<Net::Curl::Source>,
+
+=item *
+
+header collector, progress policy and trace are not enabled.
+
+=back
+
+Submitted handles are passed to workers through lock-free queues.
+Completed ones are returned the same way and signalled over an eventfd
+(a pipe on systems without eventfd), so the executor can be watched by any
+event loop.
+
+Do not use a submitted easy handle, its sinks or its sources in any way
+until it is harvested. Easy methods which use the libcurl handle, like
+setopt(), getinfo(), reset() or perform(), die if called on such handle,
+as do Net::Curl::Multi add_handle(), Net::Curl::Easy::Template apply()
+and Net::Curl::Easy::Pool put(). Sink methods die while the sink is written
+by a worker, other transfers writing to it fail with CURLE_WRITE_ERROR.
+Shared objects used by submitted handles
+must be thread safe, which requires perl with ithreads.
+
+There is no libcurl equivalent, this is an extension. Available with
+libcurl 7.68.0 and newer, not available on Windows.
+
+=head2 CONSTRUCTOR
+
+=over
+
+=item new( [THREADS] )
+
+Creates new executor with THREADS worker threads (4 by default), started
+when the first handle is submitted.
+
+=back
+
+=head2 METHODS
+
+=over
+
+=item submit( EASY, ... )
+
+Starts performing all EASY handles, each on the least busy worker thread.
+Dies if any handle cannot be performed without perl.
+
+=item fileno( )
+
+Returns file descriptor which is readable whenever there are completed
+transfers to harvest.
+
+=item wait( [TIMEOUT] )
+
+Waits up to TIMEOUT milliseconds (forever by default) for completed
+transfers. Returns true if there are some. Does not wait if nothing is
+pending.
+
+=item harvest( [MAX] )
+
+Returns up to MAX (all by default) completed transfers, oldest first, as
+a flat list of easy handle and result code pairs; in scalar context returns
+a reference to such array. Result codes are plain numbers, same as in
+L<Net::Curl::Multi/info_read_all>. Harvested handles may be used as usual
+again.
+
+When executor is destroyed, running transfers are aborted and all handles
+are released.
+
+=item pending( )
+
+Returns number of submitted handles not harvested yet.
+
+=item stats( )
+
+Returns hash reference with C<threads> started, C<submitted> and
+C<completed> (harvested) transfer counts, C<pending> transfers and
+C<inflight>, array of pending transfers on each thread.
+
+=back
+
+=head1 SEE ALSO
+
+L<Net::Curl>
+L<Net::Curl::Easy>
+L<Net::Curl::Multi>
+L<Net::Curl::Sink>
+L<Net::Curl::Source>
+
+=head1 COPYRIGHT
+
+Copyright (c) 2011-2015 Przemyslaw Iskra <sparky at pld-linux.org>.
+
+You may opt to use, copy, modify, merge, publish, distribute and/or sell
+copies of the Software, and permit persons to whom the Software is furnished
+to do so, under the terms of the MPL or the MIT/X-derivate licenses. You may
+pick one of these licenses.
+
+=cut
@@ -0,0 +1,128 @@
+package Net::Curl::Mime;
+use strict;
+use warnings;
+
+use Net::Curl ();
+
+our $VERSION = '0.57';
+
+1;
+
+__END__
+
+=head1 NAME
+
+Net::Curl::Mime - Form builder using libcurl MIME API
+
+=head1 SYNOPSIS
+
+ use Net::Curl::Easy qw(:constants);
+ use Net::Curl::Mime;
+
+ my $easy = Net::Curl::Easy->new();
+ my $mime = Net::Curl::Mime->new( $easy );
+ $mime->add( name => "comment", data => "large file attached" );
+ $mime->add( name => "file", filedata => "backup.tar",
+     type => "application/x-tar" );
+
+ $easy->setopt( CURLOPT_URL, "http://example.com/upload" );
+ $easy->setopt( CURLOPT_MIMEPOST, $mime );
+ $easy->perform();
+
+=head1 DESCRIPTION
+
+This module lets you build multipart forms with curl_mime_*() functions,
+a replacement for deprecated curl_formadd() used by L<Net::Curl::Form>.
+Contents of parts are read when they are sent, by libcurl itself (files)
+or from L<Net::Curl::Source> objects, without calling any perl code.
+Memory use does not depend on the size of the form.
+
+Available with libcurl 7.56.0 and newer.
+
+=head2 CONSTRUCTOR
+
+=over
+
+=item new( [EASY] )
+
+Creates new mime object. EASY is the handle the form is going to be used
+with, it is optional.
+
+=back
+
+=head2 METHODS
+
+=over
+
+=item add( OPTION => VALUE, ... )
+
+Adds new part to the form. Returns the mime object, so calls can be
+chained. Dies if any option is invalid. Recognized options:
+
+=over
+
+=item name, filename, type, encoder
+
+Set part name, remote file name, content type and transfer encoding.
+
+=item filedata
+
+Part contents are read from file at this path, by libcurl. Also sets
+remote file name to base name of the path.
+
+=item data
+
+Part contents are sent from a scalar, a scalar reference or an array
+reference, as if given to L<Net::Curl::Source/buffer>. With perl
+copy-on-write the strings are shared, not copied.
+
+=item source
+
+Part contents are sent from a L<Net::Curl::Source> object.
+
+=item fd
+
+Part contents are the whole file FD, see L<Net::Curl::Source/fd>.
+Not available on Windows.
+
+=item headers
+
+Array reference of custom part headers.
+
+=item subparts
+
+Another mime object, sent as a multipart part. It cannot be used on its
+own afterwards, and a mime object set as CURLOPT_MIMEPOST of any easy
+handle (including duphandle() copies) cannot be used as subparts.
+
+=back
+
+=item parts( )
+
+Returns number of parts added.
+
+=back
+
+Sources are rewound before every transfer the form is used in. Every
+part keeps its own read position, so one source may be sent in several
+parts, or uploaded by other handles at the same time.
+Do not use the same form in two transfers running at the same time.
+
+=head1 SEE ALSO
+
+L<Net::Curl>
+L<Net::Curl::Easy>
+L<Net::Curl::Form>
+L<Net::Curl::Source>
+L<curl_mime_init(3)>
+
+=head1 COPYRIGHT
+
+Copyright (c) 2011-2015 Przemyslaw Iskra <sparky at pld-linux.org>.
+
+You may opt to use, copy, modify, merge, publish, distribute and/or sell
+copies of the Software, and permit persons to whom the Software is furnished
+to do so, under the terms of the MPL or the MIT/X-derivate licenses. You may
+pick one of these licenses.
+
+=cut
@@ -98,6 +98,7 @@ Remove Net::Curl::Easy from this Net::Curl::Multi object.
 
 Calls L<curl_multi_remove_handle(3)|https://curl.haxx.se/libcurl/c/curl_multi_remove_handle.html>.
 Rethrows exceptions from callbacks.
+A handle which waits in the enqueue() queue is taken out of the queue.
 Throws L</Net::Curl::Multi::Code> on error.
 
 =item info_read( )
@@ -112,6 +113,23 @@ L<Net::Curl::Easy::Code> dualvar object.
 
 Calls L<curl_multi_info_read(3)|https://curl.haxx.se/libcurl/c/curl_multi_info_read.html>.
 
+=item info_read_all( [DETACH] )
+
+Reads all pending CURLMSG_DONE messages at once. In list context returns
+a flat list of easy handle and result code pairs, in scalar context returns
+a reference to such array. Result codes are
+L<Net::Curl::Easy::Code|Net::Curl::Easy/Net::Curl::Easy::Code> dualvar
+objects, like in info_read().
+If DETACH is true, every finished easy handle is also removed from the
+multi handle.
+
+ my @done = $multi->info_read_all( 1 );
+ while ( my ( $easy, $result ) = splice @done, 0, 2 ) {
+     warn "transfer failed: $result\n" if $result;
+ }
+
+There is no libcurl equivalent.
+
 =item fdset( )
 
 Returns read, write and exception vectors suitable for
@@ -122,6 +140,23 @@ L<select()|perlfunc/select> and L<vec()|perlfunc/vec> perl builtins.
 Calls L<curl_multi_fdset(3)|https://curl.haxx.se/libcurl/c/curl_multi_fdset.html>.
 Throws L</Net::Curl::Multi::Code> on error.
 
+=item fds( )
+
+Returns all sockets libcurl is waiting on, as a packed string of native
+int pairs: socket number and a mask of CURL_WAIT_POLL* events. Unlike
+fdset() it is not limited by FD_SETSIZE and its cost does not depend on
+socket numbers.
+
+ my %events = unpack "(ii)*", $multi->fds();
+
+When socket_action() is being used, the list is built from socket states
+reported to the socket callback. Otherwise, with libcurl 8.8.0+, it is
+obtained using
+L<curl_multi_waitfds(3)|https://curl.haxx.se/libcurl/c/curl_multi_waitfds.html>.
+Throws L</Net::Curl::Multi::Code> on error.
+
+There is no libcurl equivalent.
+
 =item timeout( )
 
 Returns timeout value in miliseconds.
@@ -173,11 +208,53 @@ It will also poll on all filehandles requested. Each event descriptor is a hash
    ...
  }
 
+OTHER_FDS may also be a L</Net::Curl::Multi::FdSet> object, or a string of
+packed C<struct curl_waitfd> entries.
+Both are passed to libcurl as they are and revents are written directly
+into them, which avoids converting hashes on every call.
+
+ my $fds = pack "(iss)*", map { $_, CURL_WAIT_POLLIN, 0 } @filenos;
+ $multi->wait( $fds, 1000 );
+ my @revents = ( unpack "(iss)*", $fds )[ map { $_ * 3 + 2 } 0 .. $#filenos ];
+
+If wakeup_fd() has been created, it is watched as well.
+
 Calls L<curl_multi_wait(3)|https://curl.haxx.se/libcurl/c/curl_multi_wait.html>
 (L<available since libcurl/7.28.0|http://curl.haxx.se/libcurl/c/curl_multi_wait.html>).
 Rethrows exceptions from callbacks.
 Throws L</Net::Curl::Multi::Code> on error.
 
+=item poll( [OTHER_FDS], TIMEOUT_MS )
+
+Same as wait(), but waits for the whole TIMEOUT_MS even if there are no
+easy handles, and can be interrupted by wakeup().
+
+Calls L<curl_multi_poll(3)|https://curl.se/libcurl/c/curl_multi_poll.html>
+(available since libcurl/7.66.0).
+
+=item wakeup( )
+
+Makes current or next poll() call return immediately. May be called
+from any thread which has access to the multi handle.
+
+Calls L<curl_multi_wakeup(3)|https://curl.se/libcurl/c/curl_multi_wakeup.html>
+(available since libcurl/7.68.0).
+
+=item wakeup_fd( )
+
+Returns a file descriptor which interrupts wait() and poll() when written
+to. It is created on first call (eventfd, or a pipe if eventfd is not
+available) and is watched automatically from then on. It is drained
+by wait(), poll() and run(). Unlike wakeup() it can be used from other perl
+threads or processes, which cannot share the multi object. Write 8 bytes
+to it:
+
+ # in the worker thread
+ open my $wake, ">&=", $wakeup_fd;
+ syswrite $wake, pack "Q", 1;
+
+There is no libcurl equivalent.
+
 =item socket_action( [SOCKET], [BITMASK] )
 
 Signalize action on a socket.
@@ -211,6 +288,154 @@ In scalar context returns number of easy handles attached.
 
 There is no libcurl equivalent.
 
+=item collect_latency( [ENABLE] )
+
+Enables or disables collection of per-host statistics of completed
+transfers. Returns the previous setting. Statistics are disabled by default.
+
+ $multi->collect_latency( 1 );
+
+Transfers are recorded when their completion is read by info_read(),
+info_read_all() or run(). Connect time, time to first byte
+(starttransfer), total time (all in microseconds, see
+L<Net::Curl::Easy/stats>) and download size are put into log-linear
+histograms kept in C, one set per host name. Every power of 2 is split
+into 16 buckets, so reported percentiles are within 1/16 of the actual
+values.
+
+There is no libcurl equivalent.
+
+=item latency( [HOST] )
+
+Returns statistics collected for HOST, or undef if no transfers to HOST
+have completed. Without HOST returns a hash reference with statistics of
+all hosts.
+
+ my $lat = $multi->latency( "example.com" );
+ printf "%d requests, p99 %d us\n", $lat->{count}, $lat->{total}->{p99};
+
+Statistics of each host are a hash reference with transfer count and
+connect, starttransfer, total and size_download hashes, each containing
+min, max, mean, p50, p90, p99 and p999 values.
+
+There is no libcurl equivalent.
+
+=item latency_reset( )
+
+Removes all statistics collected so far.
+
+There is no libcurl equivalent.
+
+=item enqueue( EASY, [PRIORITY], [HOST] )
+
+Queues EASY to be added to the multi once limits set by scheduler() allow
+it, which may be immediately. Transfers with larger PRIORITY (0 by default)
+start first, transfers with equal priority start in order of enqueue().
+Limits are applied per HOST, taken from CURLOPT_URL by default, whether
+it was set by setopt() or by a L<Net::Curl::Easy::Template>.
+
+ $multi->scheduler( max_active => 100, host_active => 2, host_rate => 1 );
+ $multi->enqueue( $easy );
+ $multi->enqueue( $robots, 10 );
+
+Queue is kept in C, per host. Hosts take turns: in every round each host
+allowed to start a transfer starts one, hosts with more important transfers
+go first. A slot is freed when completion of a transfer is read by
+info_read(), info_read_all() or run(), or when the handle is removed,
+so completions must be read for queued transfers to start. Started
+handles are attached like with add_handle(); perform() and socket_action()
+count queued transfers as running ones. timeout() accounts for transfers
+waiting for their host rate limit. remove_handle() drops a queued
+transfer without starting it.
+
+If libcurl refuses to add a queued handle when its turn comes, the
+handle is not attached and no error is thrown. It is reported like a
+completed transfer by the next info_read(), info_read_all() or run(),
+with a L</Net::Curl::Multi::Code> result holding the error of
+L<curl_multi_add_handle(3)|https://curl.haxx.se/libcurl/c/curl_multi_add_handle.html>
+instead of a L<Net::Curl::Easy::Code>. Until then it is counted as
+running.
+
+There is no libcurl equivalent.
+
+=item scheduler( LIMIT => VALUE, ... )
+
+Sets limits of enqueue(). Limits which are not given are kept, set a
+limit to 0 to remove it.
+
+=over
+
+=item max_active
+
+Maximum number of transfers started by enqueue() running at once.
+
+=item host_active
+
+Maximum number of running transfers to a single host.
+
+=item host_rate, host_burst
+
+Maximum number of transfers started per second for a single host, using
+a token bucket of host_burst (1 by default) tokens.
+
+=item max_recv_speed
+
+Download speed budget in bytes per second. No transfer is started while
+transfers started by enqueue() receive data faster than that, all
+together.
+
+=back
+
+=item queue_stats( [HOST] )
+
+Returns a hash reference with number of C<queued> and C<active> transfers,
+number of C<hosts> with queued transfers, number of transfers C<admitted>
+so far and how many times admission was delayed by host rate limits
+(C<rate_limited>) and by speed budget (C<speed_limited>), and number of
+queued transfers libcurl refused to add (C<failed>).
+
+With HOST returns C<queued>, C<active>, C<admitted> and C<tokens> of
+that host, or undef if nothing was queued for it.
+
+There is no libcurl equivalent.
+
+=item run( [TIMEOUT_MS], [CODE] )
+
+Drives all attached transfers using an event loop implemented in C
+(epoll and timerfd), until there are no running transfers left or until
+TIMEOUT_MS milliseconds pass. Negative or missing TIMEOUT_MS means no time
+limit. Returns number of transfers still running or queued. CODE is
+required if transfers are queued with enqueue().
+
+Socket and timer updates are handled internally, perl is called only when
+a transfer completes. If CODE is given, every completed easy handle is
+removed from the multi and CODE is called with the multi, the easy and
+the result as L<Net::Curl::Easy::Code|Net::Curl::Easy/Net::Curl::Easy::Code>.
+CODE may add new handles. Without CODE completed handles stay attached and
+can be collected with info_read().
+
+ $multi->run( 1000, sub {
+     my ( $multi, $easy, $result ) = @_;
+     warn "transfer failed: $result\n" if $result;
+ } );
+
+If wakeup_fd() has been created, writing to it makes run() return after
+processing events already pending.
+
+Once run() has been called, the multi is driven internally for good:
+CURLMOPT_SOCKETFUNCTION and CURLMOPT_TIMERFUNCTION callbacks are not
+called anymore. Errors thrown from CODE are rethrown.
+
+Available on Linux only. There is no libcurl equivalent.
+
+=item run_until_done( [CODE] )
+
+Same as run() without a time limit.
+
+ $multi->run_until_done( \&finished );
+
+There is no libcurl equivalent.
+
 =back
 
 =head2 FUNCTIONS
@@ -268,7 +493,8 @@ Special socket value for socket_action() method.
 Socket callback will be called only if socket_action() method is being used.
 It receives 6 arguments: multi handle, easy handle, socket file number, poll
 action, socket data (see assign), and CURLMOPT_SOCKETDATA value. It must
-return 0.
+return 0. Easy handle may be undef if the socket is being closed by libcurl
+itself, not on behalf of any transfer.
 For more information refer to L<curl_multi_socket_action(3)|https://curl.haxx.se/libcurl/c/curl_multi_socket_action.html>.
 
  sub cb_socket {
@@ -310,6 +536,51 @@ function to display a nice message.
      die $@;
  }
 
+=head2 Net::Curl::Multi::FdSet
+
+A persistent set of extra file descriptors for wait() and poll(). The set
+is kept in the form libcurl expects, so passing it costs the same no matter
+how many fds it holds. There is no libcurl equivalent.
+
+ my $set = Net::Curl::Multi::FdSet->new();
+ $set->add( fileno $control, CURL_WAIT_POLLIN );
+
+ while ( $multi->handles ) {
+     $multi->wait( $set, 1000 );
+     handle_control() if vec( $set->ready, fileno $control, 1 );
+     ...
+ }
+
+=over
+
+=item new( )
+
+Creates an empty set.
+
+=item add( FD, EVENTS )
+
+Adds FD to the set, or updates its events if it is there already. EVENTS
+is a bitmask of CURL_WAIT_POLL* constants.
+
+=item remove( FD )
+
+Removes FD from the set.
+
+=item count( )
+
+Returns number of fds in the set.
+
+=item ready( )
+
+Returns a bit vector, usable with vec(), of fds which received any events
+in last wait() or poll() call.
+
+=item revents( FD )
+
+Returns events received for FD in last wait() or poll() call.
+
+=back
+
 
 =head1 SEE ALSO
 
@@ -0,0 +1,116 @@
+package Net::Curl::Resolver;
+use strict;
+use warnings;
+
+use Net::Curl ();
+
+our $VERSION = '0.57';
+
+1;
+
+__END__
+
+=head1 NAME
+
+Net::Curl::Resolver - Parallel DNS prefetching into share objects
+
+=head1 SYNOPSIS
+
+ use Net::Curl::Share qw(:constants);
+ use Net::Curl::Resolver;
+
+ my $share = Net::Curl::Share->new();
+ $share->setopt( CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS );
+
+ my $resolver = Net::Curl::Resolver->new( $share );
+ $resolver->prefetch( "www.example.com", "cdn.example.com:8080" );
+ $resolver->wait( 2000 );
+
+ # handles using $share find those names in DNS cache
+ $easy->setopt( CURLOPT_SHARE, $share );
+
+=head1 DESCRIPTION
+
+Resolver resolves batches of host names with a pool of threads calling
+getaddrinfo(3) and loads the results into DNS cache of a share object,
+so transfers started later do not wait for name resolution. Lookups run
+in the background, no perl code is called from the threads.
+
+Resolved names are also kept by the resolver itself, for TTL seconds.
+Prefetching a name which is still fresh is a cache hit and does not start
+another lookup. getaddrinfo(3) does not report record TTLs, so the same
+TTL is used for every name. Entries loaded into share DNS cache expire
+according to CURLOPT_DNS_CACHE_TIMEOUT of handles using them (libcurl
+7.75.0+; older versions keep them until the share is destroyed).
+
+There is no libcurl equivalent, this is an extension. Not available on
+Windows nor with perl built without pthreads.
+
+=head2 CONSTRUCTOR
+
+=over
+
+=item new( SHARE, [THREADS], [TTL] )
+
+Creates a resolver loading entries into SHARE, which must share
+CURL_LOCK_DATA_DNS. THREADS (4 by default) lookups may run in parallel,
+threads are started by the first prefetch(). Resolved names are fresh for
+TTL seconds (60 by default).
+
+=back
+
+=head2 METHODS
+
+=over
+
+=item prefetch( HOST, ... )
+
+Queues HOSTs for resolving. Each HOST may be a name or "name:port", entries
+are loaded into share DNS cache for the given port, or for ports 80 and 443
+if none is specified. Returns number of names queued; names which are still
+fresh or already being resolved are not queued again.
+
+=item wait( [TIMEOUT] )
+
+Waits up to TIMEOUT milliseconds for queued lookups to finish, forever if
+TIMEOUT is negative (the default), and loads all finished ones into share
+DNS cache. Use wait( 0 ) to load whatever is ready without blocking.
+Returns number of names resolved successfully.
+
+=item pending( )
+
+Returns number of names not resolved yet.
+
+=item lookup( HOST )
+
+Returns list of addresses HOST resolved to, or empty list if HOST is not
+in resolver cache, could not be resolved or is not fresh anymore.
+
+=item ttl( [TTL] )
+
+Returns current TTL in seconds, sets a new one if TTL is given. Only names
+resolved later are affected.
+
+=item stats( )
+
+Returns hash reference with resolver statistics: C<hits> and C<misses>
+(of prefetch() and lookup() calls), C<resolved> and C<failed> lookups,
+C<pending> lookups and number of known C<hosts>.
+
+=back
+
+=head1 SEE ALSO
+
+L<Net::Curl>
+L<Net::Curl::Share>
+
+=head1 COPYRIGHT
+
+Copyright (c) 2011-2015 Przemyslaw Iskra <sparky at pld-linux.org>.
+
+You may opt to use, copy, modify, merge, publish, distribute and/or sell
+copies of the Software, and permit persons to whom the Software is furnished
+to do so, under the terms of the MPL or the MIT/X-derivate licenses. You may
+pick one of these licenses.
+
+=cut
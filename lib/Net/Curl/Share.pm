@@ -81,6 +81,102 @@ VALUE depends on whatever that option expects.
 Calls L<curl_share_setopt(3)|https://curl.haxx.se/libcurl/c/curl_share_setopt.html>.
 Throws L</Net::Curl::Share::Code> on error.
 
+=item share_all( )
+
+Shares everything that makes new connections cheaper and is available in
+libcurl: DNS cache, SSL session cache, connection cache (7.57.0+), public
+suffix list (7.61.0+) and HSTS cache (7.88.0+). Cookies are not shared,
+enable them separately if you want that. Returns the list of
+CURL_LOCK_DATA_* values which have been shared successfully.
+
+ my $share = Net::Curl::Share->new();
+ $share->share_all();
+
+ $easy_in_multi_one->setopt( CURLOPT_SHARE() => $share );
+ $easy_in_multi_two->setopt( CURLOPT_SHARE() => $share );
+
+With a shared connection cache, connections opened by easy handles in one
+multi handle can be reused by easy handles in any other multi handle.
+
+There is no libcurl equivalent.
+
+=item pool( [MAX_IDLE], [MAX_LIFETIME] )
+
+Sets connection pool limits, in seconds, for easy handles using this share.
+Connections idle for longer than MAX_IDLE are not reused and will be closed
+(CURLOPT_MAXAGE_CONN, 7.65.0+), connections older than MAX_LIFETIME are
+not reused either (CURLOPT_MAXLIFETIME_CONN, 7.80.0+). Negative or missing
+value leaves libcurl default.
+
+Limits are copied to the easy handle when CURLOPT_SHARE is set, so they
+only affect handles which set CURLOPT_SHARE after pool() was called.
+Handles already attached to the share keep their previous limits until
+CURLOPT_SHARE is set on them again. Limits may be overridden on each easy
+handle afterwards. Limit of connections per host
+is set on the multi handle, with CURLMOPT_MAX_HOST_CONNECTIONS.
+
+ $share->pool( 30, 600 );
+
+There is no libcurl equivalent.
+
+=item prewarm( URL, [COUNT], [TIMEOUT_MS] )
+
+Opens COUNT connections to the host in URL before they are needed, by
+doing COUNT parallel HEAD requests on a private multi handle. Connections
+are left in the shared connection cache, so CURL_LOCK_DATA_CONNECT must be
+shared. Returns the number of requests which succeeded. DNS and SSL session
+caches are filled as well, if they are shared.
+
+ $share->prewarm( "https://api.example.com/", 8, 2000 );
+
+Does not return until all requests have finished, or TIMEOUT_MS elapsed.
+Available since libcurl 7.57.0.
+
+These are real HEAD requests, seen by the server, its logs and anything
+that counts or rate-limits requests; pick a URL for which that is
+harmless. Connections opened with CURLOPT_CONNECT_ONLY would avoid them,
+but libcurl never hands such connections to other transfers.
+
+Multiplexing is disabled on the private multi handle, so every request
+opens its own connection, even over HTTP/2. Transfers on a multi handle
+which multiplexes (the default for HTTP/2) will still share a single
+connection to the host, so warming more than one connection is only
+useful for HTTP/1.x or with CURLMOPT_PIPELINING disabled.
+
+There is no libcurl equivalent.
+
+=item lock_spin( [COUNT] )
+
+When a lock needed by libcurl is busy, retry it COUNT times before putting
+the thread to sleep. Spinning helps when locks are held very briefly and
+there are enough CPU cores for all threads. It is 0 by default, which
+means waiting threads are parked right away. Returns the spin count in
+effect.
+
+ $share->lock_spin( 200 );
+
+Spinning is only done when perl threads are implemented with pthreads.
+
+There is no libcurl equivalent.
+
+=item lock_stats( [DATA] )
+
+Returns lock statistics for CURL_LOCK_DATA_* type DATA: number of locks
+taken with shared access, number of locks taken with exclusive (single)
+access, number of locks which were busy and had to be waited for, and
+total time spent waiting, in seconds.
+
+ my ( $shared, $single, $contended, $wait ) =
+     $share->lock_stats( CURL_LOCK_DATA_DNS );
+
+Without DATA returns a hash reference containing array references with
+the same values, for each type that has been locked at least once.
+
+Locking is only needed when perl is built with ithreads, otherwise all
+values are 0.
+
+There is no libcurl equivalent.
+
 =back
 
 =head2 FUNCTIONS
@@ -109,13 +205,15 @@ Values for setopt().
 
 =item CURL_LOCK_ACCESS_*
 
-Values passed to lock callbacks. Unused.
+Values passed to lock callbacks. Unused in perl code. Internal locks are
+read-write locks: CURL_LOCK_ACCESS_SHARED requests from different
+threads do not block each other.
 
 =item CURL_LOCK_DATA_*
 
 Values passed to lock and unlock callbacks. Unused.
 
-=item CURL_LOCK_DATA_COOKIE, CURL_LOCK_DATA_DNS
+=item CURL_LOCK_DATA_COOKIE, CURL_LOCK_DATA_DNS, CURL_LOCK_DATA_SSL_SESSION, CURL_LOCK_DATA_CONNECT, CURL_LOCK_DATA_PSL, CURL_LOCK_DATA_HSTS
 
 Values used to enable/disable shareing.
 
@@ -0,0 +1,134 @@
+package Net::Curl::Sink;
+use strict;
+use warnings;
+
+use Net::Curl ();
+
+our $VERSION = '0.57';
+
+1;
+
+__END__
+
+=head1 NAME
+
+Net::Curl::Sink - Native destinations for received data
+
+=head1 SYNOPSIS
+
+ use Net::Curl::Easy qw(:constants);
+ use Net::Curl::Sink;
+
+ open my $fh, '>', "body.bin" or die;
+ my $sink = Net::Curl::Sink->fd( $fh );
+
+ my $easy = Net::Curl::Easy->new();
+ $easy->setopt( CURLOPT_URL, "http://example.com/" );
+ $easy->setopt( CURLOPT_WRITEDATA, $sink );
+ $easy->perform();
+
+ print $sink->bytes(), " bytes written\n";
+
+=head1 DESCRIPTION
+
+Sink objects can be used as CURLOPT_WRITEDATA, CURLOPT_WRITEHEADER,
+CURLOPT_DEBUGDATA and CURLOPT_INTERLEAVEDATA values as long as no perl
+callback function is set for that option. Data received by libcurl is then
+stored directly from C code, without calling any perl code nor creating
+any perl scalars.
+
+There is no libcurl equivalent, this is an extension.
+
+=head2 CONSTRUCTORS
+
+=over
+
+=item fd( FD )
+
+Creates a sink which writes all data to a file descriptor using write(2).
+FD may be a file descriptor number or an opened perl file handle. The
+handle is flushed once, when the sink is created; afterwards perl buffering
+layers are bypassed completely, so do not print to that handle while
+the sink is in use. Sink does not close the descriptor.
+
+ my $sink = Net::Curl::Sink->fd( fileno STDOUT );
+
+=item mmap( PATH, [EXTENT] )
+
+Creates (or truncates) file PATH and maps it to memory. Received data is
+copied to the mapping, which is grown by EXTENT bytes (64MiB by default,
+rounded down to whole pages) whenever necessary. File is cut to the actual
+size of data when finish() is called or when sink is destroyed.
+
+ my $sink = Net::Curl::Sink->mmap( "/tmp/download", 256 * 1024 * 1024 );
+
+Only available if perl was built with mmap support.
+
+=item ring( CAPACITY )
+
+Creates a fixed-size ring buffer, able to hold CAPACITY bytes. If there
+is not enough space for next chunk of data and the easy handle is attached
+to a multi handle, the transfer is paused (by returning CURL_WRITEFUNC_PAUSE),
+data must be removed with drain() or drain_fd() and the transfer resumed
+using $easy->pause( CURLPAUSE_CONT ). A blocking $easy->perform() cannot be
+resumed, so there a full ring aborts the transfer with CURLE_WRITE_ERROR.
+A single chunk larger than CAPACITY aborts the transfer, so CAPACITY should
+not be smaller than CURLOPT_BUFFERSIZE (CURL_MAX_WRITE_SIZE by default).
+
+ my $sink = Net::Curl::Sink->ring( 1024 * 1024 );
+
+=back
+
+=head2 METHODS
+
+Methods die while a transfer running in L<Net::Curl::Executor> writes to
+the sink.
+
+=over
+
+=item bytes( )
+
+Returns total number of bytes stored in the sink.
+
+=item pending( )
+
+Returns number of bytes waiting in ring buffer. Always 0 for other sinks.
+
+=item drain( [MAX] )
+
+Removes up to MAX bytes (everything if MAX is not specified) from ring buffer
+and returns them as a string.
+
+ while ( length( my $data = $sink->drain( 65536 ) ) ) {
+     process( $data );
+ }
+
+=item drain_fd( FD )
+
+Writes the contents of ring buffer to file descriptor or handle FD
+using a single writev(2) call when the data wraps around. Returns number
+of bytes written, or undef on error if nothing could be written.
+
+=item finish( )
+
+For mmap sink unmaps the memory, truncates file to the size of data and
+closes it. Any data received afterwards will abort the transfer. Does
+nothing for other sinks.
+
+=back
+
+=head1 SEE ALSO
+
+L<Net::Curl>
+L<Net::Curl::Easy>
+
+=head1 COPYRIGHT
+
+Copyright (c) 2011-2015 Przemyslaw Iskra <sparky at pld-linux.org>.
+
+You may opt to use, copy, modify, merge, publish, distribute and/or sell
+copies of the Software, and permit persons to whom the Software is furnished
+to do so, under the terms of the MPL or the MIT/X-derivate licenses. You may
+pick one of these licenses.
+
+=cut
@@ -0,0 +1,105 @@
+package Net::Curl::Slist;
+use strict;
+use warnings;
+
+use Net::Curl ();
+
+our $VERSION = '0.57';
+
+1;
+
+__END__
+
+=head1 NAME
+
+Net::Curl::Slist - Shared, immutable string lists
+
+=head1 SYNOPSIS
+
+ use Net::Curl::Easy qw(:constants);
+ use Net::Curl::Slist;
+
+ my $headers = Net::Curl::Slist->new(
+     "Accept: application/json",
+     "X-Client: worker",
+ );
+
+ foreach my $uri ( @uris ) {
+     my $easy = Net::Curl::Easy->new();
+     $easy->setopt( CURLOPT_URL, $uri );
+     $easy->setopt( CURLOPT_HTTPHEADER, $headers );
+     ...
+ }
+
+=head1 DESCRIPTION
+
+Slist objects hold a list of strings converted to libcurl curl_slist once.
+They can be used as value for any option which expects an array of strings:
+CURLOPT_HTTPHEADER, CURLOPT_RESOLVE, CURLOPT_QUOTE and others. Every easy
+handle the object is set on uses the very same list, nothing is copied.
+Handles created with $easy->duphandle() share all the lists of the
+original handle too.
+
+An slist never changes once created. Calling $easy->pushopt() on a handle
+which shares its list makes a private copy of that list for the handle
+first, other handles are not affected. An slist object may be passed to
+pushopt() as well, its entries are then appended.
+
+ $easy->setopt( CURLOPT_HTTPHEADER, $headers );
+ $easy->pushopt( CURLOPT_HTTPHEADER, [ "Authorization: Bearer $token" ] );
+
+The list is released when the object and all handles using it are gone.
+
+There is no libcurl equivalent, this is an extension.
+
+=head2 CONSTRUCTORS
+
+=over
+
+=item new( ENTRY, ... )
+
+Creates a list of ENTRY strings. Undefined entries are skipped.
+
+=item extend( ENTRY, ... )
+
+Creates a new list with all entries of the old one followed by ENTRY
+strings. The old list is not modified.
+
+ my $auth_headers = $headers->extend( "Authorization: Bearer $token" );
+
+=back
+
+=head2 METHODS
+
+=over
+
+=item entries( )
+
+Returns all strings in the list.
+
+=item count( )
+
+Returns number of strings in the list.
+
+=item refcount( )
+
+Returns number of users of the list: the object itself, easy handles
+and templates it is set on.
+
+=back
+
+=head1 SEE ALSO
+
+L<Net::Curl>
+L<Net::Curl::Easy>
+
+=head1 COPYRIGHT
+
+Copyright (c) 2011-2015 Przemyslaw Iskra <sparky at pld-linux.org>.
+
+You may opt to use, copy, modify, merge, publish, distribute and/or sell
+copies of the Software, and permit persons to whom the Software is furnished
+to do so, under the terms of the MPL or the MIT/X-derivate licenses. You may
+pick one of these licenses.
+
+=cut
@@ -0,0 +1,125 @@
+package Net::Curl::Source;
+use strict;
+use warnings;
+
+use Net::Curl ();
+
+our $VERSION = '0.57';
+
+1;
+
+__END__
+
+=head1 NAME
+
+Net::Curl::Source - Native sources of uploaded data
+
+=head1 SYNOPSIS
+
+ use Net::Curl::Easy qw(:constants);
+ use Net::Curl::Source;
+
+ my $source = Net::Curl::Source->mmap( "backup.tar" );
+
+ my $easy = Net::Curl::Easy->new();
+ $easy->setopt( CURLOPT_URL, "http://example.com/backup.tar" );
+ $easy->setopt( CURLOPT_UPLOAD, 1 );
+ $easy->setopt( CURLOPT_READDATA, $source );
+ $easy->perform();
+
+=head1 DESCRIPTION
+
+Source objects can be used as CURLOPT_READDATA value as long as no perl
+CURLOPT_READFUNCTION is set. Data sent by libcurl is then copied directly
+from memory by C code, without calling any perl code nor creating any perl
+scalars.
+
+A scalar reference or an array reference given as CURLOPT_READDATA is
+turned into a buffer source automatically:
+
+ $easy->setopt( CURLOPT_READDATA, \$data );
+ $easy->setopt( CURLOPT_READDATA, [ $head, $body, $tail ] );
+
+When a source is set, CURLOPT_INFILESIZE_LARGE is set to its size (set it
+again afterwards to override) and, unless a perl CURLOPT_SEEKFUNCTION is
+used, libcurl is allowed to seek the data, so it can be sent again after
+a redirect or authentication. Setting a perl CURLOPT_READFUNCTION drops
+the source and makes the size unknown again. Every transfer starts from
+the beginning of data. Each easy handle keeps its own read position, so
+a source may be uploaded by several transfers at the same time, also by
+handles created with duphandle(). So does every L<Net::Curl::Mime> part.
+
+There is no libcurl equivalent, this is an extension.
+
+=head2 CONSTRUCTORS
+
+=over
+
+=item buffer( SCALAR, ... )
+
+Creates a source sending all SCALARs one after another. Scalar references
+may be used as well, undefined values are skipped. Values are copied when
+the source is created (with perl copy-on-write the strings are shared
+instead), later changes to the original scalars do not affect the source.
+
+ my $source = Net::Curl::Source->buffer( $header, \$payload );
+
+=item mmap( PATH )
+
+Maps file PATH to memory, read only. Data is sent directly from the mapping.
+File should not be truncated while it is mapped.
+
+Only available if perl was built with mmap support.
+
+=item fd( FD, [OFFSET], [LENGTH] )
+
+Creates a source sending LENGTH bytes of file FD starting at OFFSET
+(0 by default). If LENGTH is not specified, or is negative, everything up
+to the end of file is sent. FD may be a file descriptor number or an opened
+perl file handle, it is not closed by the source and its position is not
+changed.
+
+Data is read with pread(2) directly into libcurl upload buffer, so it is
+copied only once, from the page cache. Setting this source increases
+CURLOPT_UPLOAD_BUFFERSIZE (libcurl 7.62.0+) to 512KiB, set it again
+afterwards to use a different value. The kernel is advised the file
+will be read sequentially.
+
+ open my $fh, '<', "backup.tar" or die;
+ my $source = Net::Curl::Source->fd( $fh, $part * $partsize, $partsize );
+
+Not available on Windows.
+
+=back
+
+=head2 METHODS
+
+=over
+
+=item size( )
+
+Returns total number of bytes in the source.
+
+=item position( )
+
+Returns position reached by the last read from the source, which after
+a successful transfer equals size().
+
+=back
+
+=head1 SEE ALSO
+
+L<Net::Curl>
+L<Net::Curl::Easy>
+L<Net::Curl::Sink>
+
+=head1 COPYRIGHT
+
+Copyright (c) 2011-2015 Przemyslaw Iskra <sparky at pld-linux.org>.
+
+You may opt to use, copy, modify, merge, publish, distribute and/or sell
+copies of the Software, and permit persons to whom the Software is furnished
+to do so, under the terms of the MPL or the MIT/X-derivate licenses. You may
+pick one of these licenses.
+
+=cut
@@ -2,17 +2,26 @@
 #include "perl.h"
 #include "XSUB.h"
 
-typedef struct simplell_s simplell_t;
-struct simplell_s {
-	/* next in the linked list */
-	simplell_t *next;
-
-	/* curl option it belongs to */
+/* open addressing hash, keyed by pointer, fd or option number */
+typedef struct {
+	/* curl option, fd or pointer it belongs to */
 	PTRV key;
 
 	/* the actual data */
 	void *value;
-};
+} ptrhash_entry_t;
+
+typedef struct {
+	/* array of size slots, size is a power of 2 */
+	ptrhash_entry_t *slots;
+	size_t size;
+
+	/* number of used slots */
+	size_t count;
+} ptrhash_t;
+
+/* marks unused slot, not a valid pointer, fd nor option */
+#define PTRHASH_EMPTY ( (PTRV) -1 )
 
 typedef struct {
 	/* function that will be called */
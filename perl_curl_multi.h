@@ -24,11 +24,26 @@ struct perl_curl_multi_s {
 
 	/* list of data assigned to sockets */
 	/* key: socket fd; value: user sv */
-	simplell_t *socket_data;
+	ptrhash_t socket_data;
 
 	/* list of easy handles attached to this multi */
 	/* key: our easy pointer, value: easy SV */
-	simplell_t *easies;
+	ptrhash_t easies;
+
+	/* sockets curl wants us to watch, as reported to socket callback */
+	/* key: socket fd; value: CURL_POLL_* */
+	ptrhash_t sockets;
+
+	/* internal event loop used by run(), NULL until first used */
+	struct perl_curl_multi_loop_s *loop;
+
+	/* see wakeup_fd(): read and write end, -1 if not created */
+	int wakeup_fd[ 2 ];
+
+	/* completed transfers per host, see collect_latency() */
+	/* key: hash of host name; value: perl_curl_latency_t list */
+	ptrhash_t latency;
+	int collect_latency;
 };
 
 typedef struct perl_curl_multi_s perl_curl_multi_t;
@@ -5,19 +5,41 @@ use Test::More tests => 2;
 
 use Net::Curl;
 use Net::Curl::Easy;
+use Net::Curl::Executor;
 use Net::Curl::Form;
+use Net::Curl::Mime;
 use Net::Curl::Multi;
+use Net::Curl::Resolver;
 use Net::Curl::Share;
+use Net::Curl::Sink;
+use Net::Curl::Slist;
+use Net::Curl::Source;
 
 subtest methods => sub {
     my %methods = (
         Net::Curl:: => [ qw(version version_info getdate) ],
         Net::Curl::Easy:: => [ qw(new duphandle setopt pushopt perform
-            getinfo error strerror form multi reset share), ],
+            getinfo getinfo_multi error strerror form multi reset share
+            buffer_reuse max_body_bytes collect_headers headers progress_policy
+            progress_stats trace trace_dump stats), ],
+        Net::Curl::Easy::Pool:: => [ qw(new get put count max stats) ],
+        Net::Curl::Easy::Template:: => [ qw(new apply count) ],
+        Net::Curl::Executor:: => [ qw(new submit fileno wait harvest pending
+            stats) ],
         Net::Curl::Form:: => [ qw(new add get strerror) ],
         Net::Curl::Multi:: => [ qw(new add_handle remove_handle info_read
-            fdset timeout setopt perform socket_action strerror handles) ],
-        Net::Curl::Share:: => [ qw(new setopt strerror) ],
+            info_read_all fdset timeout setopt perform socket_action strerror
+            handles collect_latency latency latency_reset enqueue scheduler
+            queue_stats) ],
+        Net::Curl::Multi::FdSet:: => [ qw(new add remove count revents ready) ],
+        Net::Curl::Resolver:: => [ qw(new prefetch wait pending lookup ttl
+            stats) ],
+        Net::Curl::Share:: => [ qw(new setopt share_all pool lock_spin
+            lock_stats strerror) ],
+        Net::Curl::Sink:: => [ qw(fd mmap ring bytes pending drain drain_fd
+            finish) ],
+        Net::Curl::Slist:: => [ qw(new extend entries count refcount) ],
+        Net::Curl::Source:: => [ qw(buffer mmap fd size position) ],
     );
 
     while ( my ($pkg, $methods) = each %methods ) {
@@ -33,6 +55,14 @@ subtest "version-dependent methods" => sub {
 
     my @version_methods = (
         [ 'Net::Curl::Multi', 'wait', 0x071C00 ],
+        [ 'Net::Curl::Multi', 'wakeup_fd', 0x071C00 ],
+        [ 'Net::Curl::Multi', 'fds', 0x071C00 ],
+        [ 'Net::Curl::Multi', 'poll', 0x074200 ],
+        [ 'Net::Curl::Multi', 'wakeup', 0x074400 ],
+        [ 'Net::Curl::Share', 'prewarm', 0x073900 ],
+        [ 'Net::Curl::Mime', 'new', 0x073800 ],
+        [ 'Net::Curl::Mime', 'add', 0x073800 ],
+        [ 'Net::Curl::Mime', 'parts', 0x073800 ],
         [ 'Net::Curl::Multi', 'assign', 0x070F05 ],
         [ 'Net::Curl::Easy', 'pause', 0x071200 ],
         [ 'Net::Curl::Easy', 'send', 0x071202 ],
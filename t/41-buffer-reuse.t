@@ -0,0 +1,42 @@
+#!perl
+use strict;
+use warnings;
+use lib 'inc';
+use Test::More;
+use Test::HTTP::Server;
+use Net::Curl::Easy qw(:constants);
+
+my $server = Test::HTTP::Server->new;
+plan skip_all => "Could not run http server\n" unless $server;
+plan tests => 9;
+
+my $easy = Net::Curl::Easy->new();
+$easy->setopt( CURLOPT_URL, $server->uri . "repeat/200000/abcd" );
+
+is( $easy->buffer_reuse( 1 ), 0, 'disabled by default' );
+is( $easy->buffer_reuse(), 1, 'enabled' );
+
+my $body = '';
+my @kept;
+my $ro = 0;
+my $self_ok = 1;
+$easy->setopt( CURLOPT_WRITEFUNCTION, sub {
+	my ( $e, $data ) = @_;
+	$self_ok = 0 unless $e == $easy;
+	$body .= $data;
+	push @kept, \$_[1] if @kept < 2;
+	$ro++ unless eval { $_[1] = "x"; 1 };
+	return length $data;
+} );
+$easy->perform();
+
+is( length $body, 200000 * 4, 'got all data' );
+is( $body, "abcd" x 200000, 'data is correct' );
+ok( $self_ok, 'callback received the easy object' );
+ok( $ro > 0, 'data is read-only' );
+ok( scalar( @kept ) == 2 && length ${ $kept[0] } && length ${ $kept[1] },
+	'kept references got private copies' );
+is( substr( ${ $kept[0] }, 0, 8 ), "abcdabcd", 'kept copy is correct' );
+
+my $dup = $easy->duphandle();
+is( $dup->buffer_reuse(), 1, 'duphandle copies the setting' );
@@ -0,0 +1,104 @@
+#!perl
+use strict;
+use warnings;
+use lib 'inc';
+use Test::More;
+use Test::HTTP::Server;
+use File::Temp qw(tempfile);
+use Net::Curl::Easy qw(:constants);
+use Net::Curl::Multi;
+use Net::Curl::Sink;
+
+my $server = Test::HTTP::Server->new;
+plan skip_all => "Could not run http server\n" unless $server;
+plan tests => 15;
+
+my $expect = "abcd" x 100000;
+
+sub get
+{
+	my ( $sink, $easy ) = @_;
+	$easy ||= Net::Curl::Easy->new();
+	$easy->setopt( CURLOPT_URL, $server->uri . "repeat/100000/abcd" );
+	$easy->setopt( CURLOPT_WRITEDATA, $sink );
+	$easy->perform();
+	return $easy;
+}
+
+sub slurp
+{
+	open my $fh, '<', shift or die;
+	local $/;
+	return scalar <$fh>;
+}
+
+{
+	my ( $fh, $file ) = tempfile( UNLINK => 1 );
+	my $sink = Net::Curl::Sink->fd( $fh );
+	get( $sink );
+	is( $sink->bytes, length $expect, 'fd: byte count' );
+	is( slurp( $file ), $expect, 'fd: data is correct' );
+}
+
+SKIP: {
+	my $sink;
+	my ( undef, $file ) = tempfile( UNLINK => 1 );
+	skip "no mmap support", 4
+		unless eval { $sink = Net::Curl::Sink->mmap( $file, 65536 ); 1 };
+
+	my $easy = get( $sink );
+	is( $sink->bytes, length $expect, 'mmap: byte count' );
+	$sink->finish;
+	is( -s $file, length $expect, 'mmap: file truncated to data size' );
+	is( slurp( $file ), $expect, 'mmap: data is correct' );
+
+	eval { get( $sink, $easy ) };
+	ok( $@, 'mmap: writes after finish abort the transfer' );
+}
+
+{
+	my $sink = Net::Curl::Sink->ring( 1024 * 1024 );
+	get( $sink );
+	is( $sink->pending, length $expect, 'ring: all data buffered' );
+	is( $sink->drain( 4 ), "abcd", 'ring: partial drain' );
+	is( length( $sink->drain ) + 4, length $expect, 'ring: full drain' );
+	is( $sink->pending, 0, 'ring: empty' );
+}
+
+{
+	# small ring, drained from multi loop while paused
+	my $sink = Net::Curl::Sink->ring( 64 * 1024 );
+	my $easy = Net::Curl::Easy->new();
+	$easy->setopt( CURLOPT_URL, $server->uri . "repeat/100000/abcd" );
+	$easy->setopt( CURLOPT_WRITEDATA, $sink );
+	my $multi = Net::Curl::Multi->new();
+	$multi->add_handle( $easy );
+	my $out = '';
+	while ( $multi->perform ) {
+		if ( $sink->pending ) {
+			$out .= $sink->drain;
+			$easy->pause( CURLPAUSE_CONT );
+		}
+		$multi->wait( 100 ) if $multi->can( 'wait' );
+	}
+	$out .= $sink->drain;
+	is( $out, $expect, 'ring: paused transfer resumed after drain' );
+	ok( $sink->bytes >= length $expect, 'ring: byte count' );
+}
+
+{
+	# blocking perform cannot be resumed
+	my $sink = Net::Curl::Sink->ring( 64 * 1024 );
+	eval { get( $sink ) };
+	is( $@ + 0, CURLE_WRITE_ERROR, 'ring: full ring aborts blocking perform' );
+}
+
+{
+	my $sink = Net::Curl::Sink->ring( 1024 * 1024 );
+	get( $sink );
+	my ( $fh, $file ) = tempfile( UNLINK => 1 );
+	$sink->drain( 12345 );
+	is( $sink->drain_fd( $fh ), length( $expect ) - 12345, 'ring: drain_fd' );
+	close $fh;
+	is( slurp( $file ), substr( $expect, 12345 ), 'ring: drain_fd data' );
+}
@@ -0,0 +1,51 @@
+#!perl
+use strict;
+use warnings;
+use lib 'inc';
+use Test::More;
+use Test::HTTP::Server;
+use B ();
+use Net::Curl::Easy qw(:constants);
+
+my $server = Test::HTTP::Server->new;
+plan skip_all => "Could not run http server\n" unless $server;
+plan tests => 10;
+
+my $size = 500000 * 4;
+my $easy = Net::Curl::Easy->new();
+$easy->setopt( CURLOPT_URL, $server->uri . "repeat/500000/abcd" );
+
+my $body;
+$easy->setopt( CURLOPT_WRITEDATA, \$body );
+$easy->perform();
+is( length $body, $size, 'got all data' );
+ok( B::svref_2object( \$body )->LEN > $size, 'buffer preallocated' );
+
+$body = "prefix";
+$easy->perform();
+is( $body, "prefix" . "abcd" x 500000, 'data appended to existing value' );
+
+is( $easy->max_body_bytes( 1000 ), 0, 'no limit by default' );
+is( $easy->max_body_bytes(), 1000, 'limit set' );
+
+$body = undef;
+eval { $easy->perform() };
+is( $@ + 0, CURLE_WRITE_ERROR, 'aborted by Content-Length' );
+ok( !defined $body, 'nothing written' );
+
+$easy->max_body_bytes( $size );
+$body = undef;
+$easy->perform();
+is( length $body, $size, 'body of exactly max_body_bytes accepted' );
+
+$easy->setopt( CURLOPT_URL, $server->uri . "repeat/500001/abcd" );
+my $seen = 0;
+$easy->setopt( CURLOPT_WRITEFUNCTION, sub {
+	$seen += length $_[1];
+	return length $_[1];
+} );
+eval { $easy->perform() };
+is( $@ + 0, CURLE_WRITE_ERROR, 'limit applies to write callbacks' );
+
+my $dup = $easy->duphandle();
+is( $dup->max_body_bytes(), $size, 'duphandle copies the limit' );
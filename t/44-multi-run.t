@@ -0,0 +1,99 @@
+#!perl
+use strict;
+use warnings;
+use lib 'inc';
+use Test::More;
+use Test::HTTP::Server;
+use IO::Socket::INET;
+use Net::Curl::Easy qw(:constants);
+use Net::Curl::Multi qw(:constants);
+
+plan skip_all => "run() is not supported on this platform"
+	unless Net::Curl::Multi->can( 'run' );
+
+my $server = Test::HTTP::Server->new;
+plan skip_all => "Could not run http server\n" unless $server;
+plan tests => 14;
+
+my $multi = Net::Curl::Multi->new();
+my %body;
+
+sub add
+{
+	my $n = shift;
+	my $easy = Net::Curl::Easy->new( { n => $n } );
+	$easy->setopt( CURLOPT_URL, $server->uri . "repeat/$n/x" );
+	$easy->setopt( CURLOPT_WRITEDATA, \$body{ $n } );
+	$multi->add_handle( $easy );
+}
+
+add( $_ * 1000 ) foreach 1 .. 10;
+
+my @done;
+my $args_ok = 1;
+$multi->run_until_done( sub {
+	my ( $m, $easy, $result ) = @_;
+	$args_ok = 0 unless $m == $multi && $result == 0;
+	push @done, $easy->{n};
+	add( 20000 ) if $easy->{n} == 5000;
+	return 0;
+} );
+
+is( scalar @done, 11, 'all transfers completed' );
+ok( $args_ok, 'callback received multi and result' );
+is( scalar $multi->handles, 0, 'completed handles removed' );
+is( length $body{ 20000 }, 20000, 'handle added from callback completed' );
+is( join( ",", map { length $body{ $_ * 1000 } } 1 .. 10 ),
+	join( ",", map { $_ * 1000 } 1 .. 10 ), 'data is correct' );
+
+# without completion callback handles stay attached
+add( 1234 );
+is( $multi->run(), 0, 'run returns number of running transfers' );
+my ( $msg, $easy, $result ) = $multi->info_read();
+is( $easy->{n}, 1234, 'result available from info_read' );
+$multi->remove_handle( $easy );
+
+# timeout: server accepts the connection but never answers
+my $listen = IO::Socket::INET->new( Listen => 5, LocalAddr => '127.0.0.1' );
+my $stuck = Net::Curl::Easy->new();
+$stuck->setopt( CURLOPT_URL, "http://127.0.0.1:" . $listen->sockport . "/" );
+$multi->add_handle( $stuck );
+my $start = time;
+is( $multi->run( 300 ), 1, 'run returns after timeout' );
+ok( time - $start < 5, 'timeout respected' );
+
+eval {
+	$multi->run( 300, sub { die "no completions expected\n" } );
+	$multi->remove_handle( $stuck );
+	add( 10 );
+	$multi->run( -1, sub { die "from callback\n" } );
+};
+is( $@, "from callback\n", 'errors from callback are rethrown' );
+
+# sockets registered before the first run() are watched as well
+{
+	my $m = Net::Curl::Multi->new();
+	my $e = Net::Curl::Easy->new();
+	$e->setopt( CURLOPT_URL, $server->uri . "repeat/1000/x" );
+	$e->setopt( CURLOPT_WRITEDATA, \my $data );
+	$m->add_handle( $e );
+	$m->socket_action() foreach 1 .. 3;
+	my $start = time;
+	is( $m->run( 5000, sub { 0 } ), 0, 'started transfer completed' );
+	ok( time - $start < 4, 'existing sockets watched' );
+}
+
+SKIP: {
+	skip "wakeup_fd() is not supported", 2
+		unless Net::Curl::Multi->can( 'wakeup_fd' );
+
+	my $m = Net::Curl::Multi->new();
+	my $e = Net::Curl::Easy->new();
+	$e->setopt( CURLOPT_URL, "http://127.0.0.1:" . $listen->sockport . "/" );
+	$m->add_handle( $e );
+	open my $wake, ">&=", $m->wakeup_fd or die;
+	syswrite $wake, pack "Q", 1;
+	my $start = time;
+	is( $m->run( 5000 ), 1, 'wakeup_fd interrupts run' );
+	ok( time - $start < 4, 'run returned early' );
+}
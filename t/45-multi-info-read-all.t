@@ -0,0 +1,54 @@
+#!perl
+use strict;
+use warnings;
+use lib 'inc';
+use Test::More;
+use Test::HTTP::Server;
+use Net::Curl::Easy qw(:constants);
+use Net::Curl::Multi qw(:constants);
+
+my $server = Test::HTTP::Server->new;
+plan skip_all => "Could not run http server\n" unless $server;
+plan tests => 9;
+
+my $multi = Net::Curl::Multi->new();
+
+sub add_all
+{
+	my @easy;
+	foreach my $n ( 1 .. 5 ) {
+		my $easy = Net::Curl::Easy->new( { n => $n } );
+		$easy->setopt( CURLOPT_URL, $server->uri . "repeat/$n/x" );
+		$easy->setopt( CURLOPT_WRITEDATA, \$easy->{body} );
+		$multi->add_handle( $easy );
+	}
+}
+
+sub finish
+{
+	while ( $multi->perform ) {
+		$multi->wait( 1000 ) if $multi->can( 'wait' );
+	}
+}
+
+add_all();
+finish();
+
+my @done = $multi->info_read_all();
+is( scalar @done, 10, 'five pairs returned' );
+is( join( ",", sort map { $done[ $_ * 2 ]{n} } 0 .. 4 ), "1,2,3,4,5",
+	'all easies returned' );
+is( join( ",", map { 0 + $done[ $_ * 2 + 1 ] } 0 .. 4 ), "0,0,0,0,0",
+	'all transfers succeeded' );
+isa_ok( $done[1], 'Net::Curl::Easy::Code', 'result' );
+is( scalar $multi->handles, 5, 'handles still attached' );
+is( scalar( () = $multi->info_read_all() ), 0, 'queue is empty' );
+
+$multi->remove_handle( $_ ) foreach $multi->handles;
+add_all();
+finish();
+
+my $done = $multi->info_read_all( 1 );
+is( ref $done, 'ARRAY', 'arrayref in scalar context' );
+is( scalar @$done, 10, 'five pairs returned' );
+is( scalar $multi->handles, 0, 'handles detached' );
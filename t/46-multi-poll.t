@@ -0,0 +1,58 @@
+#!perl
+use strict;
+use warnings;
+use Test::More;
+use Time::HiRes qw(time);
+use Net::Curl::Easy qw(/^CURL_WAIT_/);
+use Net::Curl::Multi;
+
+plan skip_all => "curl_multi_poll() is not available"
+	unless Net::Curl::Multi->can( 'poll' );
+plan tests => 11;
+
+my $multi = Net::Curl::Multi->new();
+
+pipe my $r, my $w or die;
+syswrite $w, "x";
+
+# packed struct curl_waitfd: fd, events, revents
+my $fds = pack "iss", fileno $r, CURL_WAIT_POLLIN, 0;
+my $copy = $fds;
+$multi->poll( $fds, 1000 );
+my ( $fd, $events, $revents ) = unpack "iss", $fds;
+is( $fd, fileno $r, 'fd untouched' );
+is( $revents, CURL_WAIT_POLLIN, 'revents set in place' );
+
+my $ev = { fd => fileno $r, events => CURL_WAIT_POLLIN };
+$multi->poll( [ $ev ], 1000 );
+is( $ev->{revents}, CURL_WAIT_POLLIN, 'array of hashes still supported' );
+
+$multi->wait( $copy, 1000 );
+is( ( unpack "iss", $copy )[2], CURL_WAIT_POLLIN, 'wait accepts packed fds' );
+
+my $bad = "abc";
+eval { $multi->poll( $bad, 0 ) };
+like( $@, qr/multiple of/, 'invalid packed string rejected' );
+
+my $start = time;
+$multi->poll( 100 );
+ok( time - $start >= 0.05, 'poll waits for timeout' );
+
+$start = time;
+$multi->wakeup();
+$multi->poll( 5000 );
+ok( time - $start < 2, 'wakeup interrupts poll' );
+
+my $wfd = $multi->wakeup_fd();
+ok( $wfd > 2, 'got wakeup fd' );
+is( $multi->wakeup_fd(), $wfd, 'same fd every time' );
+
+open my $wake, ">&=", $wfd or die;
+syswrite $wake, pack( "Q", 1 );
+$start = time;
+$multi->poll( 5000 );
+ok( time - $start < 2, 'writing to wakeup fd interrupts poll' );
+
+$start = time;
+$multi->poll( 100 );
+ok( time - $start >= 0.05, 'wakeup fd drained' );
@@ -0,0 +1,52 @@
+#!perl
+use strict;
+use warnings;
+use Test::More;
+use Net::Curl::Easy qw(/^CURL_WAIT_/);
+use Net::Curl::Multi;
+
+plan skip_all => "curl_multi_wait() is implemented since libcurl/7.28.0"
+	if Net::Curl::LIBCURL_VERSION_NUM() < 0x071C00;
+plan tests => 13;
+
+my $multi = Net::Curl::Multi->new();
+my $set = Net::Curl::Multi::FdSet->new();
+
+my @pipes = map { pipe my $r, my $w or die; [ $r, $w ] } 1 .. 5;
+$set->add( fileno $_->[0], CURL_WAIT_POLLIN ) foreach @pipes;
+is( $set->count, 5, 'five fds' );
+
+$set->add( fileno $pipes[0][0], CURL_WAIT_POLLIN );
+is( $set->count, 5, 'adding same fd again updates it' );
+
+syswrite $pipes[1][1], "x";
+syswrite $pipes[3][1], "x";
+$multi->wait( $set, 1000 );
+
+my $ready = $set->ready;
+ok( vec( $ready, fileno $pipes[1][0], 1 ), 'second pipe ready' );
+ok( vec( $ready, fileno $pipes[3][0], 1 ), 'fourth pipe ready' );
+ok( !vec( $ready, fileno $pipes[0][0], 1 ), 'first pipe not ready' );
+is( $set->revents( fileno $pipes[3][0] ), CURL_WAIT_POLLIN, 'revents' );
+is( $set->revents( 12345 ), 0, 'unknown fd' );
+
+$set->remove( fileno $pipes[1][0] );
+$set->remove( fileno $pipes[1][0] );
+is( $set->count, 4, 'removed once' );
+
+$multi->wait( $set, 1000 );
+$ready = $set->ready;
+ok( !vec( $ready, fileno $pipes[1][0], 1 ), 'removed fd not watched' );
+ok( vec( $ready, fileno $pipes[3][0], 1 ), 'moved entry still watched' );
+
+sysread $pipes[3][0], my $buf, 1;
+$multi->wait( $set, 10 );
+is( $set->ready, "", 'nothing ready after timeout' );
+
+$set->remove( fileno $_->[0] ) foreach @pipes;
+is( $set->count, 0, 'empty' );
+SKIP: {
+	skip "no poll()", 1 unless $multi->can( 'poll' );
+	$multi->poll( $set, 10 );
+	pass( 'poll accepts fd set' );
+}
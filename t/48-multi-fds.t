@@ -0,0 +1,82 @@
+#!perl
+use strict;
+use warnings;
+use lib 'inc';
+use Test::More;
+use Test::HTTP::Server;
+use IO::Socket::INET;
+use Net::Curl::Easy qw(:constants /^CURL_WAIT_/);
+use Net::Curl::Multi qw(:constants);
+
+plan skip_all => "curl_multi_wait() is implemented since libcurl/7.28.0"
+	if Net::Curl::LIBCURL_VERSION_NUM() < 0x071C00;
+plan tests => 7;
+
+# server accepts connections but never answers, so sockets stay open
+my $listen = IO::Socket::INET->new( Listen => 5, LocalAddr => '127.0.0.1' );
+my $url = "http://127.0.0.1:" . $listen->sockport . "/";
+
+sub start
+{
+	my ( $multi, $drive ) = @_;
+	foreach ( 1 .. 3 ) {
+		my $easy = Net::Curl::Easy->new();
+		$easy->setopt( CURLOPT_URL, $url );
+		$multi->add_handle( $easy );
+	}
+	foreach ( 1 .. 20 ) {
+		$drive->();
+		select undef, undef, undef, 0.01;
+	}
+}
+
+sub pairs
+{
+	my %fds = unpack "(ii)*", shift;
+	return \%fds;
+}
+
+# socket_action mode
+my $multi = Net::Curl::Multi->new();
+my %seen;
+$multi->setopt( CURLMOPT_SOCKETFUNCTION, sub {
+	my ( $m, $e, $fd, $what ) = @_;
+	if ( $what == CURL_POLL_REMOVE ) {
+		delete $seen{ $fd };
+	} else {
+		$seen{ $fd } = $what;
+	}
+	return 0;
+} );
+start( $multi, sub { $multi->socket_action() } );
+
+my $fds = pairs( $multi->fds );
+is( scalar keys %$fds, 3, 'three sockets' );
+is( join( ",", sort keys %$fds ), join( ",", sort keys %seen ),
+	'same sockets as reported to socket callback' );
+my %events = ( CURL_POLL_IN, CURL_WAIT_POLLIN, CURL_POLL_OUT, CURL_WAIT_POLLOUT,
+	CURL_POLL_INOUT, CURL_WAIT_POLLIN | CURL_WAIT_POLLOUT );
+is( join( ",", map { $fds->{ $_ } } sort keys %seen ),
+	join( ",", map { $events{ $seen{ $_ } } } sort keys %seen ),
+	'events translated to CURL_WAIT_POLL*' );
+
+my ( $r, $w, $e ) = $multi->fdset;
+my @both = grep { vec( $r, $_, 1 ) || vec( $w, $_, 1 ) }
+	0 .. 8 * ( length( $r ) + length( $w ) );
+is( join( ",", @both ), join( ",", sort { $a <=> $b } keys %$fds ),
+	'fdset agrees with fds' );
+ok( !grep( { length && substr( $_, -1 ) eq "\0" } $r, $w ),
+	'vectors are trimmed' );
+
+$multi->remove_handle( $_ ) foreach $multi->handles;
+is( $multi->fds, "", 'no sockets after removal' );
+
+SKIP: {
+	skip "curl_multi_waitfds() is implemented since libcurl/8.8.0", 1
+		if Net::Curl::LIBCURL_VERSION_NUM() < 0x080800;
+
+	# perform mode, socket callback is never called
+	my $multi = Net::Curl::Multi->new();
+	start( $multi, sub { $multi->perform() } );
+	is( scalar keys %{ pairs( $multi->fds ) }, 3, 'fds in perform mode' );
+}
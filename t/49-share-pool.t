@@ -0,0 +1,84 @@
+#!perl
+use strict;
+use warnings;
+use Test::More;
+use IO::Socket::INET;
+use Net::Curl::Easy qw(:constants);
+use Net::Curl::Multi;
+use Net::Curl::Share qw(:constants);
+
+plan skip_all => "prewarm() is not supported by this libcurl"
+	unless Net::Curl::Share->can( 'prewarm' );
+
+# keep-alive server, the bundled one closes every connection
+my $listen = IO::Socket::INET->new( Listen => 10, LocalAddr => '127.0.0.1',
+	ReuseAddr => 1 );
+plan skip_all => "Could not listen\n" unless $listen;
+
+my $pid = fork;
+die "Could not fork\n" unless defined $pid;
+unless ( $pid ) {
+	local $SIG{CHLD} = 'IGNORE';
+	while ( my $c = $listen->accept ) {
+		next if fork;
+		local $/ = "\r\n\r\n";
+		while ( defined( my $req = <$c> ) ) {
+			my $body = $req =~ /^HEAD/ ? "" : "ok";
+			print $c "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\n$body";
+		}
+		exit 0;
+	}
+	exit 0;
+}
+END { kill 'TERM', $pid if $pid }
+
+plan tests => 9;
+
+my $uri = "http://127.0.0.1:" . $listen->sockport . "/";
+
+my $share = Net::Curl::Share->new();
+eval { $share->prewarm( $uri, 1 ) };
+like( $@, qr/shared connection cache/, 'prewarm requires shared connections' );
+
+my %all = map { $_ => 1 } $share->share_all();
+ok( $all{ CURL_LOCK_DATA_DNS() }, 'dns is shared' );
+ok( $all{ CURL_LOCK_DATA_CONNECT() }, 'connections are shared' );
+ok( !$all{ CURL_LOCK_DATA_COOKIE() }, 'cookies are not shared' );
+
+$share->pool( 60, 600 );
+is( $share->prewarm( $uri, 3, 5000 ), 3, 'three connections opened' );
+
+# three transfers at once on a new multi must all reuse warm connections
+my $multi = Net::Curl::Multi->new();
+my @easies;
+foreach ( 1 .. 3 ) {
+	my $easy = Net::Curl::Easy->new();
+	$easy->setopt( CURLOPT_URL, $uri );
+	$easy->setopt( CURLOPT_SHARE, $share );
+	$easy->setopt( CURLOPT_WRITEDATA, \my $body );
+	$multi->add_handle( $easy );
+	push @easies, $easy;
+}
+while ( $multi->handles ) {
+	my $active = $multi->perform();
+	while ( my ( $msg, $easy ) = $multi->info_read() ) {
+		$multi->remove_handle( $easy );
+	}
+	$multi->wait( 1000 ) if $active;
+}
+
+is( ( join ",", map { $_->getinfo( CURLINFO_RESPONSE_CODE ) } @easies ),
+	"200,200,200", 'transfers completed' );
+is( ( join ",", map { $_->getinfo( CURLINFO_NUM_CONNECTS ) } @easies ),
+	"0,0,0", 'no new connections were needed' );
+
+# idle limit applies to handles attached afterwards
+$share->pool( 0 );
+sleep 1;
+my $easy = Net::Curl::Easy->new();
+$easy->setopt( CURLOPT_URL, $uri );
+$easy->setopt( CURLOPT_SHARE, $share );
+$easy->setopt( CURLOPT_WRITEDATA, \my $body );
+$easy->perform();
+is( $body, "ok", 'transfer after pool change' );
+is( $easy->getinfo( CURLINFO_NUM_CONNECTS ), 1, 'idle connections evicted' );
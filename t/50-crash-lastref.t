@@ -7,12 +7,13 @@ use lib 'inc';
 use Test::More;
 use Test::HTTP::Server;
 use Net::Curl::Easy qw(:constants);
+use Net::Curl::Multi;
 
 local $ENV{no_proxy} = '*';
 
 my $server = Test::HTTP::Server->new;
 plan skip_all => "Could not run http server\n" unless $server;
-plan tests => 7;
+plan tests => 11;
 
 my $destroyed = 0;
 sub DESTROY {
@@ -49,3 +50,29 @@ cmp_ok( $destroyed, '>', 0, 'object resources freed' );
 cmp_ok( $headercnt, '==', 5, "got headers" );
 cmp_ok( length $out, '==', 26, "got file" );
 is( $reftype, 'Net::Curl::Easy', 'callback received correct object type' );
+
+# the object stays alive until libcurl is done with it, even if a callback
+# of a multi transfer drops every reference
+$destroyed = 0;
+my ( @alive, $error );
+my $multi = Net::Curl::Multi->new();
+my $last = Net::Curl::Easy->new();
+{ $last->{guard} = bless \my $bar, __PACKAGE__; }
+$last->setopt( CURLOPT_URL, $server->uri . "repeat/100000/x" );
+$last->setopt( CURLOPT_WRITEFUNCTION, sub {
+	my ( $easy, $data ) = @_;
+	if ( $last ) {
+		eval { $multi->remove_handle( $easy ) };
+		$error = $@;
+		undef $easy;
+		$last = undef;
+	}
+	push @alive, $destroyed;
+	return length $data;
+} );
+$multi->add_handle( $last );
+$multi->perform, $multi->wait( 50 ) while $last;
+ok( $error, 'remove_handle refused inside callback' );
+is( "@alive", join( " ", ( 0 ) x @alive ), 'not freed inside callback' );
+ok( ! defined $last, 'last reference dropped' );
+is( $destroyed, 1, 'freed after perform' );
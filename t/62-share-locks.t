@@ -0,0 +1,60 @@
+#!perl
+use strict;
+use warnings;
+use Config;
+use lib 'inc';
+use Test::More;
+use Test::HTTP::Server;
+use Net::Curl::Easy qw(:constants);
+use Net::Curl::Share qw(:constants);
+
+plan skip_all => "perl is not built with ithreads"
+	unless $Config{useithreads};
+require threads;
+
+# threads must not inherit the server, it would be killed when they exit
+sub Test::HTTP::Server::CLONE_SKIP { 1 }
+
+my $server = Test::HTTP::Server->new;
+plan skip_all => "Could not run http server\n" unless $server;
+plan tests => 8;
+my $uri = $server->uri;
+
+my $share = Net::Curl::Share->new();
+$share->setopt( CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS );
+$share->setopt( CURLSHOPT_SHARE, CURL_LOCK_DATA_COOKIE );
+
+is( $share->lock_spin(), 0, 'no spinning by default' );
+is( $share->lock_spin( 100 ), 100, 'spin count set' );
+
+my @before = $share->lock_stats( CURL_LOCK_DATA_DNS );
+is( scalar @before, 4, 'four counters per data type' );
+
+sub fetch
+{
+	my $ok = 0;
+	foreach ( 1 .. 5 ) {
+		my $easy = Net::Curl::Easy->new();
+		$easy->setopt( CURLOPT_URL, $uri . "cookie/$_" );
+		$easy->setopt( CURLOPT_SHARE, $share );
+		$easy->setopt( CURLOPT_COOKIEFILE, "" );
+		$easy->setopt( CURLOPT_WRITEDATA, \my $body );
+		$easy->perform();
+		$ok++ if $easy->getinfo( CURLINFO_RESPONSE_CODE ) == 200;
+	}
+	return $ok;
+}
+
+my @threads = map { threads->create( \&fetch ) } 1 .. 4;
+my $ok = 0;
+$ok += $_->join() foreach @threads;
+is( $ok, 20, 'all threads completed their transfers' );
+
+my ( $shared, $single, $contended, $wait ) =
+	$share->lock_stats( CURL_LOCK_DATA_DNS );
+ok( $shared + $single > 0, 'dns lock was used' );
+ok( $contended <= $shared + $single, 'contention counted once per lock' );
+cmp_ok( $wait, '>=', 0, 'wait time is not negative' );
+
+my $all = $share->lock_stats();
+ok( exists $all->{ CURL_LOCK_DATA_COOKIE() }, 'cookie lock in summary' );
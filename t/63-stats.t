@@ -0,0 +1,78 @@
+#!perl
+use strict;
+use warnings;
+use lib 'inc';
+use Test::More;
+use Test::HTTP::Server;
+use Net::Curl::Easy qw(:constants);
+use Net::Curl::Multi;
+
+my $server = Test::HTTP::Server->new;
+plan skip_all => "Could not run http server\n" unless $server;
+plan tests => 17;
+
+my $easy = Net::Curl::Easy->new();
+$easy->setopt( CURLOPT_URL, $server->uri . "repeat/1000/x" );
+$easy->setopt( CURLOPT_WRITEDATA, \my $body );
+$easy->perform();
+
+my $stats = $easy->stats();
+is( ref $stats, 'HASH', 'stats returns a hash' );
+is( $stats->{response_code}, 200, 'response code' );
+is( $stats->{size_download}, 1000, 'download size' );
+is( $stats->{num_connects}, 1, 'connection count' );
+ok( $stats->{total} >= $stats->{starttransfer}
+	&& $stats->{starttransfer} >= $stats->{connect},
+	'times are in order' );
+cmp_ok( abs( $stats->{total} - 1e6 * $easy->getinfo( CURLINFO_TOTAL_TIME ) ),
+	'<=', 1, 'total time in microseconds' );
+ok( !grep( { !/^\d+$/ } values %$stats ), 'all values are integers' );
+
+my $multi = Net::Curl::Multi->new();
+is( $multi->collect_latency( 1 ), 0, 'collection disabled by default' );
+is( $multi->collect_latency(), 1, 'collection enabled' );
+
+my @sizes = ( 100, 200, 300, 400, 5000 );
+foreach my $size ( @sizes ) {
+	my $e = Net::Curl::Easy->new();
+	$e->setopt( CURLOPT_URL, $server->uri . "repeat/$size/x" );
+	$e->setopt( CURLOPT_WRITEDATA, \my $b );
+	$multi->add_handle( $e );
+}
+while ( $multi->handles ) {
+	my $active = $multi->perform();
+	while ( my ( $msg, $e ) = $multi->info_read() ) {
+		$multi->remove_handle( $e );
+	}
+	$multi->wait( 1000 ) if $active;
+}
+
+my $all = $multi->latency();
+is_deeply( [ keys %$all ], [ '127.0.0.1' ], 'one host recorded' );
+
+my $lat = $multi->latency( '127.0.0.1' );
+is( $lat->{count}, 5, 'transfer count' );
+is( $lat->{size_download}->{min}, 100, 'min size' );
+is( $lat->{size_download}->{max}, 5000, 'max size' );
+is( $lat->{size_download}->{mean}, 1200, 'mean size' );
+# histogram buckets are within 1/16 of the value
+cmp_ok( abs( $lat->{size_download}->{p50} - 300 ), '<=', 300 / 16,
+	'median size' );
+
+$multi->latency_reset();
+is( $multi->latency( '127.0.0.1' ), undef, 'reset' );
+
+SKIP: {
+	skip "run() is not supported on this platform", 1
+		unless $multi->can( 'run' );
+
+	foreach ( 1 .. 2 ) {
+		my $e = Net::Curl::Easy->new();
+		$e->setopt( CURLOPT_URL, $server->uri . "repeat/10/x" );
+		$e->setopt( CURLOPT_WRITEDATA, \my $b );
+		$multi->add_handle( $e );
+	}
+	$multi->run_until_done( sub { 0 } );
+	is( $multi->latency( '127.0.0.1' )->{count}, 2,
+		'transfers completed by run() are recorded' );
+}
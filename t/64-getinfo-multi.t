@@ -0,0 +1,55 @@
+#!perl
+use strict;
+use warnings;
+use lib 'inc';
+use Test::More;
+use Test::HTTP::Server;
+use Net::Curl::Easy qw(:constants);
+
+my $server = Test::HTTP::Server->new;
+plan skip_all => "Could not run http server\n" unless $server;
+plan tests => 8;
+
+my $easy = Net::Curl::Easy->new();
+$easy->setopt( CURLOPT_URL, $server->uri . "repeat/1234/x" );
+$easy->setopt( CURLOPT_WRITEDATA, \my $body );
+$easy->perform();
+
+my @options = ( CURLINFO_EFFECTIVE_URL, CURLINFO_RESPONSE_CODE,
+	CURLINFO_TOTAL_TIME, CURLINFO_CONTENT_TYPE, CURLINFO_REDIRECT_COUNT );
+is_deeply( [ $easy->getinfo_multi( @options ) ],
+	[ map { $easy->getinfo( $_ ) } @options ],
+	'same values as getinfo' );
+
+is_deeply( [ $easy->getinfo_multi() ], [], 'no options' );
+
+SKIP: {
+	skip "CURLINFO_OFF_T needs libcurl 7.55.0", 2
+		if Net::Curl::LIBCURL_VERSION_NUM() < 0x073700;
+
+	my ( $size, $cl ) = $easy->getinfo_multi( CURLINFO_SIZE_DOWNLOAD_T(),
+		CURLINFO_CONTENT_LENGTH_DOWNLOAD_T() );
+	is( $size, 1234, 'off_t size' );
+	is( $cl, 1234, 'off_t content length' );
+}
+
+SKIP: {
+	skip "integer times need libcurl 7.61.0", 2
+		if Net::Curl::LIBCURL_VERSION_NUM() < 0x073D00;
+
+	my ( $total ) = $easy->getinfo_multi( CURLINFO_TOTAL_TIME_T() );
+	like( $total, qr/^\d+$/, 'integer microseconds' );
+	cmp_ok( abs( $total - 1e6 * $easy->getinfo( CURLINFO_TOTAL_TIME ) ),
+		'<=', 1, 'same as double time' );
+}
+
+SKIP: {
+	skip "CURLINFO_ACTIVESOCKET needs libcurl 7.45.0", 1
+		if Net::Curl::LIBCURL_VERSION_NUM() < 0x072D00;
+
+	is( $easy->getinfo( CURLINFO_ACTIVESOCKET() ), -1,
+		'closed socket is -1' );
+}
+
+eval { $easy->getinfo_multi( CURLINFO_RESPONSE_CODE, 0 ) };
+like( $@, qr/invalid getinfo option/, 'invalid option dies' );
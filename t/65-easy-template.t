@@ -0,0 +1,50 @@
+#!perl
+use strict;
+use warnings;
+use lib 'inc';
+use Test::More;
+use Test::HTTP::Server;
+use Net::Curl::Easy qw(:constants);
+
+my $server = Test::HTTP::Server->new;
+plan skip_all => "Could not run http server\n" unless $server;
+plan tests => 10;
+
+my @seen;
+my $tpl = Net::Curl::Easy::Template->new(
+	CURLOPT_URL, $server->uri . "echo/head",
+	CURLOPT_USERAGENT, "template/1.0",
+	CURLOPT_HTTPHEADER, [ "X-One: 1" ],
+	CURLOPT_FOLLOWLOCATION, 1,
+	CURLOPT_WRITEFUNCTION, sub { push @seen, $_[1]; length $_[1] },
+);
+is( $tpl->count, 5, 'option count' );
+
+my @easies = map { Net::Curl::Easy->new() } 1 .. 2;
+$tpl->apply( @easies );
+$_->perform() foreach @easies;
+
+is( scalar @seen, 2, 'callback set on both handles' );
+like( $seen[0], qr/^User-Agent: template\/1\.0\r?$/m, 'string option' );
+like( $seen[0], qr/^X-One: 1\r?$/m, 'slist option' );
+is( $seen[0], $seen[1], 'same request from both handles' );
+
+# appending to an applied slist must not change the template
+@seen = ();
+$easies[0]->pushopt( CURLOPT_HTTPHEADER, [ "X-Two: 2" ] );
+$easies[0]->perform();
+$easies[1]->perform();
+like( $seen[0], qr/^X-Two: 2\r?$/m, 'pushopt appends' );
+unlike( $seen[1], qr/X-Two/, 'other handle not affected' );
+
+@seen = ();
+my $easy = Net::Curl::Easy->new();
+$tpl->apply( $easy );
+$easy->perform();
+unlike( $seen[0], qr/X-Two/, 'template not affected' );
+
+eval { Net::Curl::Easy::Template->new( CURLOPT_URL ) };
+like( $@, qr/option => value pairs/, 'odd number of arguments' );
+
+eval { Net::Curl::Easy::Template->new( 12345678, 1 ) };
+like( $@, qr/invalid option/i, 'invalid option' );
@@ -0,0 +1,53 @@
+#!perl
+use strict;
+use warnings;
+use lib 'inc';
+use Test::More;
+use Test::HTTP::Server;
+use Net::Curl::Easy qw(:constants);
+use Net::Curl::Slist;
+
+my $server = Test::HTTP::Server->new;
+plan skip_all => "Could not run http server\n" unless $server;
+plan tests => 15;
+
+my $slist = Net::Curl::Slist->new( "X-One: 1", undef, "X-Two: 2" );
+is_deeply( [ $slist->entries ], [ "X-One: 1", "X-Two: 2" ], 'entries' );
+is( $slist->count, 2, 'count' );
+is( $slist->refcount, 1, 'owned by the object only' );
+
+my $more = $slist->extend( "X-Three: 3" );
+is( ref $more, 'Net::Curl::Slist', 'extend returns an slist' );
+is( $more->count, 3, 'extended list' );
+is( $slist->count, 2, 'original list unchanged' );
+
+sub request
+{
+	my $easy = shift;
+	$easy->setopt( CURLOPT_URL, $server->uri . "echo/head" );
+	$easy->setopt( CURLOPT_WRITEDATA, \my $body );
+	$easy->perform();
+	return $body;
+}
+
+my @easies = map { Net::Curl::Easy->new() } 1 .. 3;
+$_->setopt( CURLOPT_HTTPHEADER, $slist ) foreach @easies;
+is( $slist->refcount, 4, 'list shared by handles' );
+
+my $dup = $easies[0]->duphandle();
+is( $slist->refcount, 5, 'list shared by duphandle' );
+like( request( $dup ), qr/^X-Two: 2\r?$/m, 'duphandle sends headers' );
+
+$easies[0]->pushopt( CURLOPT_HTTPHEADER, [ "X-Four: 4" ] );
+is( $slist->refcount, 4, 'pushopt made a private copy' );
+my $head = request( $easies[0] );
+like( $head, qr/^X-One: 1\r?$/m, 'shared entries kept' );
+like( $head, qr/^X-Four: 4\r?$/m, 'new entry appended' );
+unlike( request( $easies[1] ), qr/X-Four/, 'other handles not affected' );
+
+$easies[2]->pushopt( CURLOPT_HTTPHEADER, $more );
+like( request( $easies[2] ), qr/^X-Three: 3\r?$/m, 'pushopt with an slist' );
+
+undef $dup;
+@easies = ();
+is( $slist->refcount, 1, 'references released' );
@@ -0,0 +1,112 @@
+#!perl
+use strict;
+use warnings;
+use Test::More;
+use IO::Socket::INET;
+use Scalar::Util qw(refaddr weaken);
+use Net::Curl::Easy qw(:constants);
+use Net::Curl::Multi;
+
+# keep-alive server which returns request head as body
+my $listen = IO::Socket::INET->new( Listen => 10, LocalAddr => '127.0.0.1',
+	ReuseAddr => 1 );
+plan skip_all => "Could not listen\n" unless $listen;
+
+my $pid = fork;
+die "Could not fork\n" unless defined $pid;
+unless ( $pid ) {
+	local $SIG{CHLD} = 'IGNORE';
+	while ( my $c = $listen->accept ) {
+		next if fork;
+		local $/ = "\r\n\r\n";
+		while ( defined( my $req = <$c> ) ) {
+			printf $c "HTTP/1.1 200 OK\r\nContent-Length: %d\r\n\r\n%s",
+				length $req, $req;
+		}
+		exit 0;
+	}
+	exit 0;
+}
+END { kill 'TERM', $pid if $pid }
+
+plan tests => 23;
+
+my $uri = "http://127.0.0.1:" . $listen->sockport . "/";
+
+my $tpl = Net::Curl::Easy::Template->new(
+	CURLOPT_URL, $uri,
+	CURLOPT_USERAGENT, "pool/1.0",
+);
+my $pool = Net::Curl::Easy::Pool->new( 2, $tpl );
+is( $pool->max, 2, 'pool size' );
+
+my $easy = $pool->get();
+is( ref $easy, 'Net::Curl::Easy', 'got an easy handle' );
+my @chunks;
+$easy->setopt( CURLOPT_WRITEFUNCTION, sub { push @chunks, $_[1]; length $_[1] } );
+$easy->{id} = 1;
+$easy->perform();
+like( join( "", @chunks ), qr/^User-Agent: pool\/1\.0\r$/m, 'template applied' );
+my $addr = refaddr $easy;
+
+my $copy = $easy;
+eval { $pool->put( $easy ) };
+like( $@, qr/referenced elsewhere/, 'handle still in use is refused' );
+undef $copy;
+
+ok( $pool->put( $easy ), 'handle returned' );
+is( $easy, undef, 'caller reference taken away' );
+is( $pool->count, 1, 'one idle handle' );
+
+@chunks = ();
+$easy = $pool->get();
+is( refaddr $easy, $addr, 'same handle handed out' );
+is_deeply( [ keys %$easy ], [], 'base hash emptied' );
+
+$easy->setopt( CURLOPT_WRITEDATA, \my $body );
+$easy->perform();
+is( scalar @chunks, 0, 'callbacks were reset' );
+like( $body, qr/^User-Agent: pool\/1\.0\r$/m, 'template applied again' );
+is( $easy->getinfo( CURLINFO_NUM_CONNECTS ), 0, 'connection kept' );
+
+my $multi = Net::Curl::Multi->new();
+$multi->add_handle( $easy );
+eval { $pool->put( $easy ) };
+like( $@, qr/attached to a multi/, 'handle in a multi is refused' );
+$multi->remove_handle( $easy );
+
+if ( $multi->can( 'enqueue' ) ) {
+	$multi->scheduler( max_active => 1 );
+	$multi->enqueue( Net::Curl::Easy->new(), 0, "localhost" );
+	$multi->enqueue( $easy, 0, "localhost" );
+	eval { $pool->put( $easy ) };
+	like( $@, qr/attached to a multi/, 'queued handle is refused' );
+	undef $multi;
+} else {
+	pass( 'no scheduler' );
+}
+
+my @more = map { $pool->get() } 1 .. 2;
+my $pooled = $easy;
+weaken( $pooled );
+is( ( join ",", map { $pool->put( $_ ) } $easy, @more ), "1,1,0",
+	'pool does not grow over its size' );
+ok( defined $more[1], 'handle not taken by a full pool' );
+eval { $pool->put( $pooled ) };
+like( $@, qr/in a pool already/, 'handle cannot be put twice' );
+
+is_deeply( $pool->stats, { created => 3, reused => 1, idle => 2 },
+	'stats' );
+
+is( $pool->max( 0 ), 2, 'old size returned' );
+is( $pool->count, 0, 'idle handles dropped' );
+
+# handles of a subclass
+@My::Easy::ISA = qw(Net::Curl::Easy);
+my $sub = Net::Curl::Easy::Pool->new( 1, undef, "My::Easy" );
+$easy = $sub->get();
+is( ref $easy, 'My::Easy', 'new handle blessed into pool class' );
+$sub->put( $easy );
+is( ref $sub->get(), 'My::Easy', 'class kept for reused handle' );
+eval { Net::Curl::Easy::Pool->new( 1, undef, "Net::Curl::Multi" ) };
+like( $@, qr/subclass/, 'class must be an easy class' );
@@ -0,0 +1,149 @@
+#!perl
+use strict;
+use warnings;
+use lib 'inc';
+use Test::More;
+use Test::HTTP::Server;
+use File::Temp qw(tempfile);
+use Net::Curl::Easy qw(:constants);
+use Net::Curl::Multi;
+use Net::Curl::Source;
+
+my $server = Test::HTTP::Server->new;
+plan skip_all => "Could not run http server\n" unless $server;
+plan tests => 22;
+
+sub upload
+{
+	my ( $readdata, $easy ) = @_;
+	$easy ||= Net::Curl::Easy->new();
+	$easy->setopt( CURLOPT_URL, $server->uri . "echo/body" );
+	$easy->setopt( CURLOPT_UPLOAD, 1 );
+	$easy->setopt( CURLOPT_HTTPHEADER, [ "Expect:" ] );
+	$easy->setopt( CURLOPT_READDATA, $readdata ) if defined $readdata;
+	$easy->setopt( CURLOPT_WRITEDATA, \my $body );
+	$easy->perform();
+	return $body;
+}
+
+my $data = join "", map { chr( $_ % 251 ) } 1 .. 300_000;
+is( upload( \$data ), $data, 'scalar reference' );
+is( upload( [ "abc", undef, \"def", "ghi" ] ), "abcdefghi",
+	'array reference' );
+
+# plain references are copied when READDATA is set, not read on transfer
+{
+	my $body = "before";
+	my $easy = Net::Curl::Easy->new();
+	$easy->setopt( CURLOPT_READDATA, \$body );
+	$body = "after";
+	is( upload( undef, $easy ), "before", 'scalar copied at setopt time' );
+}
+
+my $source = Net::Curl::Source->buffer( "x" x 1000, \( "y" x 1000 ) );
+is( $source->size, 2000, 'source size' );
+is( upload( $source ), ( "x" x 1000 ) . ( "y" x 1000 ), 'buffer source' );
+is( $source->position, 2000, 'everything was read' );
+
+my $copy = "original";
+$source = Net::Curl::Source->buffer( $copy );
+$copy = "changed";
+is( upload( $source ), "original", 'data copied when source was created' );
+
+my $easy = Net::Curl::Easy->new();
+upload( $source, $easy );
+is( upload( undef, $easy ), "original", 'second transfer starts over' );
+is( upload( undef, $easy->duphandle() ), "original", 'duphandle' );
+
+my @calls;
+$easy = Net::Curl::Easy->new();
+$easy->setopt( CURLOPT_READFUNCTION, sub {
+	my ( $easy, $max, $uservar ) = @_;
+	push @calls, $uservar;
+	return @calls > 1 ? 0 : \$$uservar;
+} );
+# test server does not understand chunked uploads
+$easy->setopt( CURLOPT_INFILESIZE, 8 );
+is( upload( \"callback", $easy ), "callback", 'perl callback still works' );
+is( ref $calls[0], 'SCALAR', 'and receives READDATA as is' );
+
+# size of callback state is not the upload size
+sub chunks
+{
+	my ( $easy, $max, $n ) = @_;
+	return $$n++ < 3 ? \"chunk$$n" : 0;
+}
+$easy = Net::Curl::Easy->new();
+$easy->setopt( CURLOPT_READFUNCTION, \&chunks );
+$easy->setopt( CURLOPT_INFILESIZE, 18 );
+is( upload( \( my $n1 = 0 ), $easy ), "chunk1chunk2chunk3",
+	'READDATA is not a source with perl callback' );
+$easy = Net::Curl::Easy->new();
+$easy->setopt( CURLOPT_READDATA, \( my $n2 = 0 ) );
+$easy->setopt( CURLOPT_READFUNCTION, \&chunks );
+$easy->setopt( CURLOPT_INFILESIZE, 18 );
+is( upload( undef, $easy ), "chunk1chunk2chunk3",
+	'source dropped when perl callback is set' );
+
+# duplicated handles read the same source at the same time
+{
+	my $multi = Net::Curl::Multi->new();
+	my $easy = Net::Curl::Easy->new();
+	$easy->setopt( CURLOPT_URL, $server->uri . "echo/body" );
+	$easy->setopt( CURLOPT_UPLOAD, 1 );
+	$easy->setopt( CURLOPT_HTTPHEADER, [ "Expect:" ] );
+	$easy->setopt( CURLOPT_READDATA, Net::Curl::Source->buffer( $data ) );
+	my @easies = ( $easy, $easy->duphandle(), $easy->duphandle() );
+	my @bodies;
+	foreach my $i ( 0 .. $#easies ) {
+		$easies[ $i ]->setopt( CURLOPT_WRITEDATA, \$bodies[ $i ] );
+		$multi->add_handle( $easies[ $i ] );
+	}
+	while ( $multi->perform ) {
+		$multi->wait( 100 ) if $multi->can( 'wait' );
+	}
+	is( scalar( grep { defined $_ && $_ eq $data } @bodies ), 3,
+		'concurrent uploads of one source' );
+}
+
+# libcurl seeks the data to skip the part which is not uploaded
+$source = Net::Curl::Source->buffer( "01234", "56789" );
+$easy = Net::Curl::Easy->new();
+$easy->setopt( CURLOPT_RESUME_FROM_LARGE, 6 );
+is( upload( $source, $easy ), "6789", 'seek' );
+
+SKIP: {
+	skip "mmap is not supported", 3 unless Net::Curl::Source->can( 'mmap' );
+
+	my ( $fh, $file ) = tempfile( UNLINK => 1 );
+	binmode $fh;
+	print $fh $data;
+	close $fh;
+
+	my $source = Net::Curl::Source->mmap( $file );
+	is( $source->size, length $data, 'mmap source size' );
+	is( upload( $source ), $data, 'mmap source' );
+
+	( $fh, $file ) = tempfile( UNLINK => 1 );
+	close $fh;
+	my $body = upload( Net::Curl::Source->mmap( $file ) );
+	ok( !defined $body || $body eq "", 'empty file' );
+}
+
+SKIP: {
+	skip "fd sources are not supported", 4 unless Net::Curl::Source->can( 'fd' );
+
+	my ( $fh, $file ) = tempfile( UNLINK => 1 );
+	binmode $fh;
+	print $fh $data;
+	close $fh;
+	open $fh, '<', $file or die "Cannot open $file: $!\n";
+
+	my $source = Net::Curl::Source->fd( $fh, 1000, 100_000 );
+	is( $source->size, 100_000, 'fd source size' );
+	is( upload( $source ), substr( $data, 1000, 100_000 ), 'fd source range' );
+
+	$source = Net::Curl::Source->fd( fileno $fh, 250_000 );
+	is( $source->size, 50_000, 'fd source up to the end of file' );
+	is( upload( $source ), substr( $data, 250_000 ), 'fd source' );
+}
@@ -0,0 +1,57 @@
+#!perl
+use strict;
+use warnings;
+use lib 'inc';
+use Test::More;
+use Test::HTTP::Server;
+use Net::Curl::Easy qw(:constants);
+use Net::Curl::Share qw(:constants);
+use Net::Curl::Resolver;
+
+plan skip_all => "Net::Curl::Resolver is not available\n"
+	unless Net::Curl::Resolver->can( "new" );
+my $server = Test::HTTP::Server->new;
+plan skip_all => "Could not run http server\n" unless $server;
+plan tests => 14;
+
+my $share = Net::Curl::Share->new();
+eval { Net::Curl::Resolver->new( $share ) };
+like( $@, qr/does not share DNS/, 'share must share DNS cache' );
+
+$share->setopt( CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS );
+my $resolver = Net::Curl::Resolver->new( $share, 2, 30 );
+is( $resolver->ttl, 30, 'ttl' );
+
+my $port = $server->port;
+is( $resolver->prefetch( "localhost:$port", "nonexistent.invalid" ), 2,
+	'two names queued' );
+is( $resolver->prefetch( "LOCALHOST" ), 0, 'name already queued' );
+is( $resolver->wait( 10_000 ), 1, 'one name resolved' );
+is( $resolver->pending, 0, 'nothing pending' );
+
+my @addrs = $resolver->lookup( "localhost" );
+ok( scalar( grep { $_ eq "127.0.0.1" or $_ eq "::1" } @addrs ),
+	'localhost addresses' );
+is_deeply( [ $resolver->lookup( "nonexistent.invalid" ) ], [],
+	'failed lookup has no addresses' );
+
+is( $resolver->prefetch( "localhost" ), 0, 'fresh name is a hit' );
+
+my $stats = $resolver->stats;
+is( $stats->{resolved}, 1, 'resolved count' );
+is( $stats->{failed}, 1, 'failed count' );
+is( $stats->{hosts}, 2, 'hosts count' );
+is( $stats->{hits}, 2, 'hits count' );
+
+my $easy = Net::Curl::Easy->new();
+my $trace = "";
+$easy->setopt( CURLOPT_SHARE, $share );
+$easy->setopt( CURLOPT_URL, "http://localhost:$port/echo/head" );
+$easy->setopt( CURLOPT_WRITEDATA, \my $body );
+$easy->setopt( CURLOPT_VERBOSE, 1 );
+$easy->setopt( CURLOPT_DEBUGFUNCTION, sub {
+	$trace .= $_[2] if $_[1] == CURLINFO_TEXT;
+	return 0;
+} );
+$easy->perform();
+like( $trace, qr/found in DNS cache/i, 'transfer used prefetched entry' );
@@ -0,0 +1,114 @@
+#!perl
+use strict;
+use warnings;
+use lib 'inc';
+use Test::More;
+use Test::HTTP::Server;
+use Net::Curl::Easy qw(:constants);
+
+sub Test::HTTP::Server::Request::moved
+{
+	my $self = shift;
+	$self->{out_code} = "302 Found";
+	$self->{out_headers}->{location} = "/cookie/2";
+	$self->{out_headers}->{x_first} = "yes";
+	return "";
+}
+
+sub Test::HTTP::Server::Request::folded
+{
+	my $self = shift;
+	$self->{out_headers}->{x_folded} = "first\r\n  second\r\n\tthird";
+	return "";
+}
+
+my $server = Test::HTTP::Server->new;
+plan skip_all => "Could not run http server\n" unless $server;
+plan tests => 21;
+
+my $easy = Net::Curl::Easy->new();
+$easy->setopt( CURLOPT_URL, $server->uri . "cookie/3" );
+$easy->setopt( CURLOPT_WRITEDATA, \my $body );
+
+eval { $easy->headers };
+like( $@, qr/not enabled/, 'collector must be enabled' );
+
+is( $easy->collect_headers( 1 ), 0, 'collector was disabled' );
+$easy->perform();
+
+my @all = $easy->headers;
+is( scalar( grep { $_ eq "Set-Cookie" } @all ), 3, 'all pairs in order' );
+is( { @all }->{"Content-Type"}, "text/plain", 'names as received' );
+
+my @cookies = $easy->headers( "set-cookie" );
+is( scalar @cookies, 3, 'all values of repeated header' );
+like( $cookies[0], qr/^test_cookie1=true;/, 'first value' );
+like( $cookies[2], qr/^test_cookie3=true;/, 'values in order' );
+is( scalar $easy->headers( "SET-COOKIE" ), $cookies[0],
+	'scalar context, case insensitive' );
+is( scalar $easy->headers( "CONTENT-TYPE" ), "text/plain", 'single value' );
+is( scalar $easy->headers( "X-Missing" ), undef, 'missing header' );
+
+# only headers of the last response are kept
+$easy->setopt( CURLOPT_URL, $server->uri . "moved" );
+$easy->setopt( CURLOPT_FOLLOWLOCATION, 1 );
+$easy->perform();
+is( scalar $easy->headers( "X-First" ), undef, 'previous response dropped' );
+is( scalar( () = $easy->headers( "Set-Cookie" ) ), 2, 'final response' );
+
+$easy->setopt( CURLOPT_URL, $server->uri . "folded" );
+$easy->perform();
+is( scalar $easy->headers( "X-Folded" ), "first second third",
+	'folded value joined' );
+
+# collecting does not disturb perl header callback
+my $lines = 0;
+$easy->setopt( CURLOPT_HEADERFUNCTION, sub { $lines++; length $_[1] } );
+$easy->setopt( CURLOPT_URL, $server->uri . "cookie/1" );
+$easy->setopt( CURLOPT_FOLLOWLOCATION, 0 );
+$easy->perform();
+ok( $lines >= 4, 'header callback called' );
+is( scalar( () = $easy->headers( "Set-Cookie" ) ), 1, 'collected as well' );
+
+$easy->setopt( CURLOPT_HEADERFUNCTION, undef );
+$easy->perform();
+is( scalar( () = $easy->headers( "Set-Cookie" ) ), 1,
+	'still collected without header callback' );
+
+# method name callbacks are looked up again after methods change
+{
+	package My::Easy;
+	our @ISA = qw(Net::Curl::Easy);
+	sub on_write { $_[2]->{calls}++; length $_[1] }
+}
+my $data = { calls => 0 };
+my $my = My::Easy->new();
+$my->setopt( CURLOPT_URL, $server->uri . "repeat/10/x" );
+$my->setopt( CURLOPT_WRITEFUNCTION, "on_write" );
+$my->setopt( CURLOPT_WRITEDATA, $data );
+$my->perform();
+is( $data->{calls}, 1, 'method called with original userdata' );
+
+{
+	no warnings 'redefine';
+	*My::Easy::on_write = sub { $_[2]->{calls} += 10; length $_[1] };
+}
+$my->perform();
+is( $data->{calls}, 11, 'redefined method called' );
+
+# userdata is not copied, but assigning to it fails the callback
+my ( $err, $after );
+$my->setopt( CURLOPT_WRITEFUNCTION, sub {
+	eval { $_[2] = "changed" };
+	$err = $@;
+	$after = $_[2];
+	length $_[1];
+} );
+$my->setopt( CURLOPT_WRITEDATA, "stored" );
+$my->perform();
+like( $err, qr/read-only/, 'assigning to userdata dies' );
+is( $after, "stored", 'userdata left unchanged' );
+
+$my->setopt( CURLOPT_WRITEFUNCTION, sub { $_[2] = "changed"; length $_[1] } );
+eval { $my->perform() };
+like( $@, qr/read-only/, 'callback assigning to userdata fails perform' );
@@ -0,0 +1,85 @@
+#!perl
+use strict;
+use warnings;
+use lib 'inc';
+use Test::More;
+use Test::HTTP::Server;
+use Time::HiRes qw(time);
+use Net::Curl::Easy qw(:constants);
+
+# nothing is sent for a while, as if connecting took long
+sub Test::HTTP::Server::Request::late
+{
+	select undef, undef, undef, 0.6;
+	return "x" x 65536;
+}
+
+my $server = Test::HTTP::Server->new;
+plan skip_all => "Could not run http server\n" unless $server;
+plan tests => 16;
+
+my $size = 2 * 1024 * 1024;
+
+sub transfer
+{
+	my ( $speed, @policy ) = @_;
+	my $easy = Net::Curl::Easy->new();
+	$easy->setopt( CURLOPT_URL, $server->uri . "repeat/$size/x" );
+	$easy->setopt( CURLOPT_WRITEDATA, \my $body );
+	$easy->setopt( CURLOPT_MAX_RECV_SPEED_LARGE, $speed ) if $speed;
+	$easy->progress_policy( @policy );
+	return $easy;
+}
+
+my $calls = 0;
+my $easy = transfer( 4 * 1024 * 1024, interval_ms => 100 );
+$easy->setopt( CURLOPT_PROGRESSFUNCTION, sub { $calls++; 0 } );
+my $start = time;
+$easy->perform();
+my $elapsed = time - $start;
+my $stats = $easy->progress_stats;
+is( $stats->{delivered}, $calls, 'perl called for delivered ticks only' );
+ok( $stats->{ticks} > $calls, 'some ticks were not delivered' );
+ok( $calls <= $elapsed * 10 + 2, 'at most every 100ms' );
+ok( !exists $stats->{aborted}, 'not aborted' );
+
+$calls = 0;
+$easy = transfer( 0, bytes => 512 * 1024 );
+$easy->setopt( CURLOPT_PROGRESSFUNCTION, sub { $calls++; 0 } );
+$easy->perform();
+ok( $calls >= 1 && $calls <= 4, 'at most every 512KiB' );
+
+# abort policies work without perl callback
+$easy = transfer( 0, max_bytes => 1024 * 1024 );
+eval { $easy->perform() };
+is( $@ + 0, CURLE_ABORTED_BY_CALLBACK, 'max_bytes aborts' );
+is( $easy->progress_stats->{aborted}, "max_bytes", 'max_bytes reason' );
+
+$easy = transfer( 64 * 1024, min_speed => 256 * 1024, window_ms => 200 );
+eval { $easy->perform() };
+is( $@ + 0, CURLE_ABORTED_BY_CALLBACK, 'min_speed aborts' );
+is( $easy->progress_stats->{aborted}, "min_speed", 'min_speed reason' );
+
+$easy = Net::Curl::Easy->new();
+$easy->setopt( CURLOPT_URL, $server->uri . "late" );
+$easy->setopt( CURLOPT_WRITEDATA, \my $late );
+$easy->progress_policy( min_speed => 1024, window_ms => 200 );
+eval { $easy->perform() };
+is( $@, "", 'min_speed window starts with the first byte' );
+
+$easy = transfer( 64 * 1024, deadline => time + 0.3 );
+$start = time;
+eval { $easy->perform() };
+is( $@ + 0, CURLE_ABORTED_BY_CALLBACK, 'deadline aborts' );
+is( $easy->progress_stats->{aborted}, "deadline", 'deadline reason' );
+ok( time - $start < 3, 'aborted soon after deadline' );
+
+# same handle, policy removed
+$easy->progress_policy();
+is( $easy->progress_stats, undef, 'policy removed' );
+$easy->setopt( CURLOPT_MAX_RECV_SPEED_LARGE, 0 );
+eval { $easy->perform() };
+is( $@, "", 'transfer completes without policy' );
+
+eval { $easy->progress_policy( max_speed => 1 ) };
+like( $@, qr/unknown progress policy/, 'unknown policy' );
@@ -0,0 +1,58 @@
+#!perl
+use strict;
+use warnings;
+use lib 'inc';
+use Test::More;
+use Test::HTTP::Server;
+use Net::Curl::Easy qw(:constants);
+
+my $server = Test::HTTP::Server->new;
+plan skip_all => "Could not run http server\n" unless $server;
+plan tests => 15;
+
+my $easy = Net::Curl::Easy->new();
+$easy->setopt( CURLOPT_URL, $server->uri . "repeat/100000/x" );
+$easy->setopt( CURLOPT_WRITEDATA, \my $body );
+
+eval { $easy->trace_dump };
+like( $@, qr/not enabled/, 'trace must be enabled' );
+
+$easy->trace( 1000, 16 );
+$easy->perform();
+
+my @events = $easy->trace_dump;
+ok( scalar @events, 'events recorded' );
+my ( $out ) = grep { $_->[1] == CURLINFO_HEADER_OUT } @events;
+like( $out->[2], qr/^GET \//, 'request header recorded' );
+is( length $out->[2], 16, 'data truncated to snaplen' );
+ok( $out->[3] > 16, 'original length kept' );
+ok( abs( $out->[0] - time ) < 60, 'epoch timestamp' );
+my $data = 0;
+$data += $_->[3] for grep { $_->[1] == CURLINFO_DATA_IN } @events;
+is( $data, 100000, 'all body data accounted for' );
+ok( !grep( { $events[ $_ ]->[0] < $events[ $_ - 1 ]->[0] } 1 .. $#events ),
+	'oldest first' );
+
+# ring keeps only the newest events
+$easy->trace( 4 );
+$easy->perform();
+@events = $easy->trace_dump( 1 );
+is( scalar @events, 4, 'ring size' );
+is( $events[-1]->[1], CURLINFO_TEXT, 'newest event is last' );
+is( scalar( () = $easy->trace_dump ), 0, 'cleared' );
+
+# perl debug callback still called
+my $calls = 0;
+$easy->setopt( CURLOPT_DEBUGFUNCTION, sub { $calls++; 0 } );
+$easy->perform();
+ok( $calls > 4, 'debug callback called' );
+is( scalar( () = $easy->trace_dump ), 4, 'and events recorded' );
+
+# verbose mode is not left enabled
+$easy->trace( 0 );
+$calls = 0;
+$easy->perform();
+is( $calls, 0, 'verbose restored when trace stops' );
+
+eval { $easy->trace( ~0 >> 1, 256 ) };
+like( $@, qr/too large/, 'ring size overflow' );
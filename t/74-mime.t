@@ -0,0 +1,131 @@
+#!perl
+use strict;
+use warnings;
+use lib 'inc';
+use Test::More;
+use Test::HTTP::Server;
+use File::Temp qw(tempfile);
+use Net::Curl::Easy qw(:constants);
+use Net::Curl::Source;
+use Net::Curl::Multi;
+
+BEGIN {
+	plan skip_all => "MIME API requires libcurl 7.56.0"
+		if Net::Curl::LIBCURL_VERSION_NUM() < 0x073800;
+	require Net::Curl::Mime;
+}
+
+my $server = Test::HTTP::Server->new;
+plan skip_all => "Could not run http server\n" unless $server;
+plan tests => 20;
+
+my ( $fh, $file ) = tempfile( UNLINK => 1 );
+print $fh "file contents\n" x 1000;
+close $fh;
+
+my $easy = Net::Curl::Easy->new();
+$easy->setopt( CURLOPT_URL, $server->uri . "echo/body" );
+$easy->setopt( CURLOPT_HTTPHEADER, [ "Expect:" ] );
+
+sub post
+{
+	my $mime = shift;
+	$easy->setopt( CURLOPT_MIMEPOST, $mime );
+	$easy->setopt( CURLOPT_WRITEDATA, \my $body );
+	$easy->perform();
+	return $body;
+}
+
+my $data = "perl data";
+my $mime = Net::Curl::Mime->new( $easy );
+is( $mime->add( name => "string", data => "plain string" ), $mime,
+	'add returns mime object' );
+$mime->add( name => "ref", data => \$data, type => "text/x-perl" )
+	->add( name => "array", data => [ "one", \"two" ] )
+	->add( name => "file", filedata => $file, type => "text/plain" )
+	->add( name => "source", source => Net::Curl::Source->buffer( "native" ),
+		headers => [ "X-Part: source" ] );
+is( $mime->parts, 5, 'parts counted' );
+
+my $body = post( $mime );
+like( $body, qr/name="string"\r\n\r\nplain string\r\n/, 'scalar data' );
+like( $body, qr/name="ref"\r\nContent-Type: text\/x-perl\r\n\r\nperl data\r\n/,
+	'scalar reference, type' );
+like( $body, qr/name="array"\r\n\r\nonetwo\r\n/, 'array reference' );
+like( $body, qr/name="file"; filename="[^"]+"\r\nContent-Type: text\/plain/,
+	'file part' );
+is( scalar( () = $body =~ /file contents\n/g ), 1000, 'file sent by libcurl' );
+like( $body, qr/X-Part: source\r\n\r\nnative\r\n/, 'source and headers' );
+
+# sources are rewound for next transfer
+my $again = post( $mime );
+s/-{20,}\w+//g for $again, $body;
+is( $again, $body, 'same form sent again' );
+
+SKIP: {
+	skip "fd source not available on Windows", 1 if $^O eq 'MSWin32';
+	open my $in, '<', $file or die;
+	my $fdmime = Net::Curl::Mime->new();
+	$fdmime->add( name => "fd", fd => $in );
+	like( post( $fdmime ), qr/name="fd"\r\n\r\n(file contents\n){1000}\r\n/,
+		'fd part' );
+}
+
+my $sub = Net::Curl::Mime->new();
+$sub->add( data => "alternative one", type => "text/plain" );
+$sub->add( data => "<p>alternative two</p>", type => "text/html" );
+my $outer = Net::Curl::Mime->new();
+$outer->add( name => "alt", subparts => $sub );
+undef $sub;
+$body = post( $outer );
+like( $body, qr/Content-Type: multipart\/mixed; boundary=/, 'subparts' );
+like( $body, qr/alternative one.*alternative two/s, 'subparts contents' );
+
+# the form stays alive while set in the handle
+my $dup = $easy->duphandle();
+undef $outer;
+$easy->setopt( CURLOPT_WRITEDATA, \my $kept );
+$easy->perform();
+like( $kept, qr/alternative two/, 'form kept by handle' );
+
+$dup->setopt( CURLOPT_WRITEDATA, \my $duped );
+$dup->perform();
+like( $duped, qr/alternative two/, 'form duplicated' );
+
+eval { Net::Curl::Mime->new()->add( name => "x", size => 10 ) };
+like( $@, qr/unknown mime part option 'size'/, 'unknown option' );
+
+# posted mime cannot become subparts, the parent would free it
+my $posted = Net::Curl::Mime->new();
+$posted->add( name => "posted", data => "posted" );
+$easy->setopt( CURLOPT_MIMEPOST, $posted );
+eval { Net::Curl::Mime->new()->add( name => "sub", subparts => $posted ) };
+like( $@, qr/posted by an easy handle/, 'posted mime refused as subparts' );
+$easy->setopt( CURLOPT_MIMEPOST, undef );
+eval { Net::Curl::Mime->new()->add( name => "sub", subparts => $posted ) };
+is( $@, '', 'subparts once no longer posted' );
+
+# every part and every easy handle reads a source from its own position
+my $shared = Net::Curl::Source->buffer( "shared source" );
+my $twice = Net::Curl::Mime->new();
+$twice->add( name => "a", source => $shared )->add( name => "b", source => $shared );
+my $upload = Net::Curl::Easy->new();
+$upload->setopt( CURLOPT_URL, $server->uri . "echo/body" );
+$upload->setopt( CURLOPT_POST, 1 );
+$upload->setopt( CURLOPT_HTTPHEADER, [ "Expect:" ] );
+$upload->setopt( CURLOPT_READDATA, $shared );
+$upload->setopt( CURLOPT_POSTFIELDSIZE, 13 );
+$upload->setopt( CURLOPT_WRITEDATA, \my $uploaded );
+$easy->setopt( CURLOPT_MIMEPOST, $twice );
+$easy->setopt( CURLOPT_WRITEDATA, \my $both );
+
+my $multi = Net::Curl::Multi->new();
+$multi->add_handle( $_ ) for $easy, $upload;
+while ( $multi->handles ) {
+	$multi->perform;
+	$multi->wait( 100 );
+	$multi->info_read_all( 1 );
+}
+like( $both, qr/name="a"\r\n\r\nshared source\r\n/, 'first part' );
+like( $both, qr/name="b"\r\n\r\nshared source\r\n/, 'second part' );
+is( $uploaded, "shared source", 'same source uploaded at once' );
@@ -0,0 +1,155 @@
+#!perl
+use strict;
+use warnings;
+use lib 'inc';
+use Test::More;
+use Test::HTTP::Server;
+use File::Temp qw(tempdir);
+use Net::Curl::Easy qw(:constants);
+use Net::Curl::Sink;
+use Net::Curl::Source;
+use Net::Curl::Executor;
+
+BEGIN {
+	plan skip_all => "Net::Curl::Executor is not available"
+		unless Net::Curl::Executor->can( "new" );
+}
+
+my $server = Test::HTTP::Server->new;
+plan skip_all => "Could not run http server\n" unless $server;
+plan tests => 31;
+
+my $dir = tempdir( CLEANUP => 1 );
+my $executor = Net::Curl::Executor->new( 3 );
+
+my %size;
+for my $i ( 1 .. 12 ) {
+	my $easy = Net::Curl::Easy->new( { id => $i } );
+	$size{ $i } = 1000 * $i * $i;
+	$easy->setopt( CURLOPT_URL, $server->uri . "repeat/$size{ $i }/x" );
+	$easy->setopt( CURLOPT_WRITEDATA, Net::Curl::Sink->mmap( "$dir/$i" ) );
+	$executor->submit( $easy );
+}
+is( $executor->pending, 12, 'all submitted' );
+
+my $rin = '';
+vec( $rin, $executor->fileno, 1 ) = 1;
+ok( select( my $rout = $rin, undef, undef, 10 ), 'fileno becomes readable' );
+
+my ( @done, %ok );
+while ( $executor->pending ) {
+	$executor->wait( 10000 ) or last;
+	push @done, $executor->harvest;
+}
+is( scalar @done, 24, 'all harvested' );
+while ( my ( $easy, $result ) = splice @done, 0, 2 ) {
+	$ok{ $easy->{id} } = $result == 0
+		&& $easy->getinfo( CURLINFO_SIZE_DOWNLOAD ) == $size{ $easy->{id} };
+	$easy->setopt( CURLOPT_WRITEDATA, undef );
+}
+is( scalar( grep { $_ } values %ok ), 12, 'all transfers succeeded' );
+is( -s "$dir/12", 144000, 'data written by sink' );
+
+my $stats = $executor->stats;
+is( $stats->{threads}, 3, 'threads started' );
+is( $stats->{completed}, 12, 'completed' );
+is( "@{ $stats->{inflight} }", "0 0 0", 'nothing in flight' );
+
+# upload from source, response and headers to fds
+open my $out, '+>', "$dir/echo" or die;
+open my $hdr, '+>', "$dir/headers" or die;
+my $easy = Net::Curl::Easy->new();
+$easy->setopt( CURLOPT_URL, $server->uri . "echo/body" );
+$easy->setopt( CURLOPT_POST, 1 );
+$easy->setopt( CURLOPT_HTTPHEADER, [ "Expect:" ] );
+$easy->setopt( CURLOPT_READDATA, [ "native ", "upload" ] );
+$easy->setopt( CURLOPT_POSTFIELDSIZE, 13 );
+$easy->setopt( CURLOPT_WRITEDATA, Net::Curl::Sink->fd( $out ) );
+$easy->setopt( CURLOPT_HEADERDATA, Net::Curl::Sink->fd( $hdr ) );
+$executor->submit( $easy );
+
+eval { $easy->perform() };
+like( $@, qr/running in an executor/, 'cannot perform while submitted' );
+eval { $executor->submit( $easy ) };
+like( $@, qr/running in an executor already/, 'cannot submit twice' );
+
+# libcurl handle belongs to the worker thread now
+my %busy = (
+	setopt => sub { $easy->setopt( CURLOPT_URL, "http://localhost/" ) },
+	getinfo => sub { $easy->getinfo( CURLINFO_RESPONSE_CODE ) },
+	reset => sub { $easy->reset() },
+	apply => sub { Net::Curl::Easy::Template->new( CURLOPT_VERBOSE, 0 )
+		->apply( $easy ) },
+	put => sub { Net::Curl::Easy::Pool->new()->put( $easy ) },
+);
+foreach my $name ( sort keys %busy ) {
+	eval { $busy{ $name }->() };
+	like( $@, qr/running in an executor/, "cannot $name while submitted" );
+}
+
+$executor->wait( 10000 );
+my ( $same, $result ) = $executor->harvest( 1 );
+is( $same, $easy, 'same object returned' );
+is( $result, 0, 'upload succeeded' );
+seek $out, 0, 0;
+is( scalar <$out>, "native upload", 'source uploaded' );
+seek $hdr, 0, 0;
+like( scalar <$hdr>, qr{^HTTP/1\.\d 200}, 'headers written' );
+
+# regular callbacks are back
+$easy->setopt( CURLOPT_WRITEDATA, \my $body );
+$easy->setopt( CURLOPT_HEADERDATA, undef );
+$easy->perform();
+is( $body, "native upload", 'handle usable after harvest' );
+
+$easy = Net::Curl::Easy->new();
+$easy->setopt( CURLOPT_URL, "http://127.0.0.1:1/" );
+$executor->submit( $easy );
+$executor->wait( 10000 );
+( undef, $result ) = $executor->harvest;
+is( $result, CURLE_COULDNT_CONNECT, 'failure reported' );
+
+# only handles which never call perl are accepted
+$easy = Net::Curl::Easy->new();
+$easy->setopt( CURLOPT_WRITEFUNCTION, sub { length $_[1] } );
+eval { $executor->submit( $easy ) };
+like( $@, qr/perl callbacks/, 'perl callback rejected' );
+$easy = Net::Curl::Easy->new();
+$easy->setopt( CURLOPT_WRITEDATA, \my $scalar );
+eval { $executor->submit( $easy ) };
+like( $@, qr/Net::Curl::Sink/, 'scalar destination rejected' );
+$easy->setopt( CURLOPT_WRITEDATA, Net::Curl::Sink->ring( 65536 ) );
+eval { $executor->submit( $easy ) };
+like( $@, qr/ring sinks/, 'ring sink rejected' );
+is( $executor->pending, 0, 'nothing submitted' );
+
+# a sink is written by a single worker at a time
+my $shared = Net::Curl::Sink->mmap( "$dir/shared" );
+my $e1 = Net::Curl::Easy->new();
+$e1->setopt( CURLOPT_URL, $server->uri . "repeat/100000/x" );
+$e1->setopt( CURLOPT_WRITEDATA, $shared );
+my $e2 = $e1->duphandle();
+eval { $executor->submit( $e1, $e2 ) };
+like( $@, qr/sink is in use/, 'duphandle sharing a sink rejected' );
+is( $executor->pending, 1, 'first one submitted' );
+eval { $shared->bytes };
+like( $@, qr/sink is in use/, 'sink busy while written' );
+$executor->wait( 10000 );
+( undef, $result ) = $executor->harvest;
+is( $shared->bytes, 100000, 'sink usable after harvest' );
+$executor->submit( $e2 );
+$executor->wait( 10000 );
+( undef, $result ) = $executor->harvest;
+is( $shared->bytes, 200000, 'duphandle submitted after harvest' );
+
+# running transfers are interrupted and handles released on destruction
+$easy = Net::Curl::Easy->new();
+$easy->setopt( CURLOPT_URL, $server->uri . "repeat/10000000/x" );
+$easy->setopt( CURLOPT_MAX_RECV_SPEED_LARGE, 100000 );
+$executor->submit( $easy );
+undef $executor;
+$easy->setopt( CURLOPT_URL, $server->uri . "repeat/10/x" );
+$easy->setopt( CURLOPT_MAX_RECV_SPEED_LARGE, 0 );
+$easy->setopt( CURLOPT_WRITEDATA, \my $again );
+$easy->perform();
+is( $again, "x" x 10, 'handle usable after executor is gone' );
@@ -0,0 +1,226 @@
+#!perl
+use strict;
+use warnings;
+use lib 'inc';
+use Test::More;
+use Test::HTTP::Server;
+use Time::HiRes qw(time);
+use Net::Curl::Easy qw(:constants);
+use Net::Curl::Multi qw(:constants);
+
+sub Test::HTTP::Server::Request::slow
+{
+	select undef, undef, undef, 0.3;
+	return "slow";
+}
+
+my $server = Test::HTTP::Server->new;
+plan skip_all => "Could not run http server\n" unless $server;
+plan tests => 39;
+
+my ( $port ) = $server->uri =~ m{:(\d+)/};
+
+sub easy
+{
+	my ( $path, $name, $host ) = @_;
+	my $easy = Net::Curl::Easy->new( { name => $name } );
+	$easy->setopt( CURLOPT_URL,
+		"http://" . ( $host || "127.0.0.1" ) . ":$port/$path" );
+	$easy->setopt( CURLOPT_WRITEDATA, \$easy->{body} );
+	return $easy;
+}
+
+# plain perform/wait/info_read_all loop, reports the most active transfers
+sub drive
+{
+	my ( $multi, @order ) = @_;
+	my ( $max, %host_max ) = ( 0 );
+	for (;;) {
+		my $running = $multi->perform;
+		my $stats = $multi->queue_stats;
+		$max = $stats->{active} if $stats->{active} > $max;
+		foreach my $host ( qw(127.0.0.1 localhost) ) {
+			my $h = $multi->queue_stats( $host ) or next;
+			$host_max{ $host } = $h->{active}
+				if $h->{active} > ( $host_max{ $host } || 0 );
+		}
+
+		my @done = $multi->info_read_all( 1 );
+		while ( my ( $easy, $result ) = splice @done, 0, 2 ) {
+			push @order, $easy->{name};
+		}
+		last unless $running or $multi->queue_stats->{queued};
+
+		my $timeout = $multi->timeout;
+		$timeout = 50 if $timeout < 0 or $timeout > 50;
+		$multi->wait( $timeout );
+	}
+	return ( \@order, $max, \%host_max );
+}
+
+my $multi = Net::Curl::Multi->new();
+$multi->scheduler( max_active => 2 );
+$multi->enqueue( easy( "slow", $_ ) ) for 1 .. 6;
+my $stats = $multi->queue_stats;
+is( $stats->{active}, 2, 'limited number started' );
+is( $stats->{queued}, 4, 'the rest is queued' );
+is( $stats->{hosts}, 1, 'one host waiting' );
+is( scalar $multi->handles, 2, 'only started handles attached' );
+
+my $start = time;
+my ( $order, $max ) = drive( $multi );
+is( scalar @$order, 6, 'all transfers completed' );
+is( $max, 2, 'never more than max_active' );
+ok( time - $start >= 0.85, 'transfers ran in three rounds' );
+is( $multi->queue_stats->{admitted}, 6, 'admitted' );
+
+# most important first, then in order of enqueue()
+$multi->scheduler( max_active => 1 );
+$multi->enqueue( easy( "slow", "first" ) );
+$multi->enqueue( easy( "echo/head", "low" ) );
+$multi->enqueue( easy( "echo/head", "high" ), 5 );
+$multi->enqueue( easy( "echo/head", "low2" ) );
+( $order ) = drive( $multi );
+is( "@$order", "first high low low2", 'priority order' );
+
+# per-host limit, hosts take turns
+$multi->scheduler( max_active => 0, host_active => 1 );
+foreach my $i ( 1 .. 3 ) {
+	$multi->enqueue( easy( "slow", "a$i" ) );
+	$multi->enqueue( easy( "slow", "b$i", "localhost" ) );
+}
+my $host_max;
+( $order, $max, $host_max ) = drive( $multi );
+is( $max, 2, 'one transfer per host' );
+is( $host_max->{localhost}, 1, 'host limit' );
+is( scalar @$order, 6, 'all completed' );
+is( $multi->queue_stats( "LOCALHOST" )->{admitted}, 3, 'host stats' );
+is( $multi->queue_stats( "example.com" ), undef, 'unknown host' );
+
+# request rate per host
+$multi->scheduler( host_active => 0, host_rate => 10, host_burst => 2 );
+$multi->enqueue( easy( "echo/head", $_ ) ) for 1 .. 5;
+is( $multi->queue_stats->{active}, 2, 'burst started at once' );
+my $timeout = $multi->timeout;
+ok( $timeout >= 0 && $timeout <= 101, 'timeout covers next token' );
+$start = time;
+( $order ) = drive( $multi );
+is( scalar @$order, 5, 'rate limited transfers completed' );
+ok( time - $start >= 0.25, 'rate limit respected' );
+ok( $multi->queue_stats->{rate_limited}, 'rate limit counted' );
+
+# removed transfer gives its slot away
+$multi->scheduler( max_active => 1, host_rate => 0 );
+my $removed = easy( "slow", "removed" );
+$multi->enqueue( $removed );
+$multi->enqueue( easy( "echo/head", "next" ) );
+$multi->remove_handle( $removed );
+is( $multi->queue_stats->{active}, 1, 'queued transfer started' );
+
+eval { $multi->add_handle( $removed ); $multi->enqueue( $removed ) };
+like( $@, qr/attached to a multi handle already/, 'cannot enqueue twice' );
+$multi->remove_handle( $removed );
+
+# queued transfer is dropped by remove_handle
+drive( $multi );
+my $first = easy( "slow", "first" );
+my $dropped = easy( "echo/head", "dropped" );
+$multi->enqueue( $first );
+$multi->enqueue( easy( "echo/head", "kept" ) );
+$multi->enqueue( $dropped, 1 );
+$multi->remove_handle( $dropped );
+is( $multi->queue_stats->{queued}, 1, 'removed from queue' );
+eval { $multi->remove_handle( $dropped ) };
+like( $@, qr/not attached to any/, 'dropped handle not queued' );
+( $order ) = drive( $multi );
+is( "@$order", "first kept", 'dropped transfer never started' );
+$dropped->perform();
+like( $dropped->{body}, qr{^GET /echo/head}, 'dropped handle usable' );
+
+my $other = Net::Curl::Multi->new();
+$other->scheduler( max_active => 1 );
+$other->enqueue( easy( "slow", "busy" ) );
+$other->enqueue( $dropped );
+eval { $multi->remove_handle( $dropped ) };
+like( $@, qr/queued in another multi/, 'queued in another multi' );
+undef $other;
+
+# host taken from URL set by a template
+my $tpl = Net::Curl::Easy::Template->new(
+	CURLOPT_URL, "http://localhost:$port/echo/head" );
+my $templated = Net::Curl::Easy->new( { name => "templated" } );
+$tpl->apply( $templated );
+$templated->setopt( CURLOPT_WRITEDATA, \$templated->{body} );
+$multi->enqueue( $templated );
+is( $multi->queue_stats( "localhost" )->{active}, 1, 'host from template URL' );
+drive( $multi );
+
+# limits which are not given are kept
+$multi->scheduler( host_active => 1 );
+$multi->enqueue( easy( "echo/head", "kept1" ) );
+$multi->enqueue( easy( "echo/head", "kept2", "localhost" ) );
+is( $multi->queue_stats->{active}, 1, 'max_active kept' );
+drive( $multi );
+$multi->scheduler( max_active => 0, host_active => 0 );
+
+eval { $multi->enqueue( Net::Curl::Easy->new() ) };
+like( $@, qr/no URL/, 'host needed' );
+$multi->enqueue( Net::Curl::Easy->new(), 0, "example.com" );
+
+eval { $multi->scheduler( max_speed => 1 ) };
+like( $@, qr/unknown scheduler limit/, 'unknown limit' );
+
+SKIP: {
+	skip "run() not available", 3 unless $multi->can( "run" );
+	my $loop = Net::Curl::Multi->new();
+	$loop->scheduler( max_active => 2 );
+	$loop->enqueue( easy( "echo/head", $_ ) ) for 1 .. 5;
+	eval { $loop->run() };
+	like( $@, qr/without a callback/, 'run needs a callback' );
+
+	my @done;
+	is( $loop->run( 10000, sub { push @done, $_[1]->{name} } ), 0,
+		'run drives queued transfers' );
+	is( scalar @done, 5, 'all completed by run' );
+}
+
+# a handle libcurl refuses to add is reported, not thrown
+SKIP: {
+	skip "CURLM_RECURSIVE_API_CALL not available", 5
+		unless Net::Curl::Multi->can( "CURLM_RECURSIVE_API_CALL" );
+	my $refusing = Net::Curl::Multi->new();
+	my $inner = easy( "echo/head", "inner" );
+	my $outer = easy( "echo/head", "outer" );
+	$outer->setopt( CURLOPT_WRITEFUNCTION, sub {
+		# adding a handle from inside a callback is refused by libcurl
+		$refusing->enqueue( $inner ) if $inner;
+		undef $inner;
+		return length $_[1];
+	} );
+	$refusing->add_handle( $outer );
+	my %result;
+	while ( $refusing->perform ) {
+		$refusing->wait( 100 );
+		my @done = $refusing->info_read_all( 1 );
+		while ( my ( $easy, $result ) = splice @done, 0, 2 ) {
+			$result{ $easy->{name} } = $result;
+		}
+	}
+	my @done = $refusing->info_read_all( 1 );
+	while ( my ( $easy, $result ) = splice @done, 0, 2 ) {
+		$result{ $easy->{name} } = $result;
+	}
+	is( 0 + $result{outer}, 0, 'completed transfer returned' );
+	isa_ok( $result{inner}, 'Net::Curl::Multi::Code', 'refused result' );
+	is( 0 + $result{inner}, CURLM_RECURSIVE_API_CALL, 'add_handle error' );
+	is( $refusing->queue_stats->{failed}, 1, 'failure counted' );
+	is( $refusing->queue_stats->{queued}, 0, 'nothing left in queue' );
+}
+
+# queued handles are released with the multi
+my $queued = easy( "echo/head", "queued" );
+$multi->scheduler( max_active => 1 );
+$multi->enqueue( $queued );
+undef $multi;
+$queued->perform();
+like( $queued->{body}, qr{^GET /echo/head}, 'queued handle released' );